@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * Shared benchmark plumbing: TSC calibration + CSV result logging
+ *
+ * Every benchmark in this directory:
+ * 1. Runs against the REAL driver code (same descriptor rings, same
+ *    poll/submit paths) in software-loopback mode by default, or
+ *    against hardware when a PCI resource path is passed.
+ * 2. Prints a human-readable summary matching the README format.
+ * 3. Appends one CSV row per run so results can be diffed per commit:
+ *
+ *        ./latency_test --csv results.csv --label $(git rev-parse --short HEAD)
+ *
+ * The CSV columns are stable; a missing metric is left empty.
+ */
+
+#include <ull_nic/common_types.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace bench {
+
+/**
+ * Measure the actual TSC frequency instead of trusting the 2.8 GHz
+ * default in tsc_to_ns() - a 5% frequency error is a 5% latency error.
+ *
+ * One ~50ms calibration against CLOCK_MONOTONIC at startup is plenty
+ * (TSC is invariant on every box we run on).
+ */
+inline uint64_t calibrate_tsc_hz() {
+    const uint64_t t0_ns = ull_nic::get_wall_time_ns();
+    const uint64_t t0_tsc = ull_nic::get_timestamp();
+
+    // Spin ~50ms
+    while (ull_nic::get_wall_time_ns() - t0_ns < 50'000'000) {
+    }
+
+    const uint64_t t1_tsc = ull_nic::get_timestamp();
+    const uint64_t t1_ns = ull_nic::get_wall_time_ns();
+
+    return (t1_tsc - t0_tsc) * 1'000'000'000ULL / (t1_ns - t0_ns);
+}
+
+/** Convert a TSC delta to nanoseconds using the calibrated frequency */
+inline uint64_t tsc_delta_ns(uint64_t ticks, uint64_t tsc_hz) {
+    return ticks * 1'000'000'000ULL / tsc_hz;
+}
+
+/**
+ * Command-line options shared by all benchmarks
+ */
+struct Options {
+    const char* csv_path = nullptr;   // --csv <file>: append result row
+    const char* label = "dev";        // --label <id>: commit hash / tag
+    const char* pci_device = nullptr; // --pci <path>: hardware mode
+    uint64_t iterations = 1'000'000;  // --iters <n>
+    uint64_t seconds = 5;             // --seconds <n> (throughput test)
+
+    static Options parse(int argc, char** argv) {
+        Options opt;
+        for (int i = 1; i < argc; i++) {
+            if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+                opt.csv_path = argv[++i];
+            } else if (!strcmp(argv[i], "--label") && i + 1 < argc) {
+                opt.label = argv[++i];
+            } else if (!strcmp(argv[i], "--pci") && i + 1 < argc) {
+                opt.pci_device = argv[++i];
+            } else if (!strcmp(argv[i], "--iters") && i + 1 < argc) {
+                opt.iterations = strtoull(argv[++i], nullptr, 10);
+            } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+                opt.seconds = strtoull(argv[++i], nullptr, 10);
+            }
+        }
+        return opt;
+    }
+};
+
+/**
+ * Append one result row; writes the header if the file is new.
+ *
+ * Columns: label,test,samples,p50_ns,p99_ns,p999_ns,max_ns,mpps,gbps
+ */
+inline void append_csv(const Options& opt, const char* test,
+                       uint64_t samples,
+                       uint64_t p50_ns, uint64_t p99_ns,
+                       uint64_t p999_ns, uint64_t max_ns,
+                       double mpps, double gbps) {
+    if (!opt.csv_path) {
+        return;
+    }
+
+    FILE* f = fopen(opt.csv_path, "a");
+    if (!f) {
+        fprintf(stderr, "warning: cannot open %s for append\n", opt.csv_path);
+        return;
+    }
+
+    // Header only when the file was just created
+    if (ftell(f) == 0) {
+        fprintf(f, "label,test,samples,p50_ns,p99_ns,p999_ns,max_ns,mpps,gbps\n");
+    }
+
+    fprintf(f, "%s,%s,%llu,%llu,%llu,%llu,%llu,%.3f,%.3f\n",
+            opt.label, test,
+            static_cast<unsigned long long>(samples),
+            static_cast<unsigned long long>(p50_ns),
+            static_cast<unsigned long long>(p99_ns),
+            static_cast<unsigned long long>(p999_ns),
+            static_cast<unsigned long long>(max_ns),
+            mpps, gbps);
+    fclose(f);
+}
+
+/** A 64-byte market-data-sized test frame */
+inline void fill_test_packet(uint8_t* buf, size_t len, uint64_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(i);
+    }
+    std::memcpy(buf, &seq, sizeof(seq));
+}
+
+constexpr size_t TEST_PACKET_SIZE = 64;
+
+} // namespace bench
@@ -0,0 +1,180 @@
+/**
+ * Comparison: our direct-MMIO path vs a DPDK-style generic RX path
+ *
+ * We obviously cannot link DPDK into this tree, so the "DPDK" side is a
+ * faithful cost model of what rte_eth_rx_burst adds on top of raw
+ * descriptor access, executed for real (not sleep-based):
+ *
+ *   - indirect call through an ops table (eth_dev->rx_pkt_burst)
+ *   - mbuf metadata initialization (~2 cache lines per packet)
+ *   - a second descriptor-to-mbuf field translation pass
+ *   - mempool get/put (pointer ring round trip per packet)
+ *
+ * Our side is the same workload through poll_rx_burst() directly.
+ * Both sides run against identical loopback rings, so the delta is the
+ * abstraction cost - which is exactly what we are selling.
+ *
+ * Usage:
+ *   ./comparison_dpdk [--iters N] [--csv results.csv] [--label <commit>]
+ */
+
+#include <ull_nic/custom_nic_driver.hpp>
+#include <ull_nic/latency_histogram.hpp>
+#include "bench_common.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using hft::hardware::CustomNICDriver;
+using hft::hardware::RxView;
+
+namespace {
+
+/** Minimal rte_mbuf-shaped metadata block (two cache lines, like DPDK) */
+struct alignas(64) FakeMbuf {
+    void* buf_addr;
+    uint64_t buf_iova;
+    uint16_t data_off;
+    uint16_t refcnt;
+    uint16_t nb_segs;
+    uint16_t port;
+    uint64_t ol_flags;
+    uint32_t pkt_len;
+    uint16_t data_len;
+    uint16_t vlan_tci;
+    uint64_t hash_rss;
+    uint8_t pad[64 - 2];  // Second line: pool ptr, next ptr, tx offloads...
+};
+
+/** Pointer-ring mempool, like rte_mempool's per-core cache */
+struct FakeMempool {
+    static constexpr size_t POOL_SIZE = 1024;
+    FakeMbuf storage[POOL_SIZE];
+    FakeMbuf* ring[POOL_SIZE];
+    size_t top = 0;
+
+    FakeMempool() {
+        for (size_t i = 0; i < POOL_SIZE; i++) {
+            ring[i] = &storage[i];
+        }
+        top = POOL_SIZE;
+    }
+    FakeMbuf* get() { return (top > 0) ? ring[--top] : nullptr; }
+    void put(FakeMbuf* m) { ring[top++] = m; }
+};
+
+/** The generic burst-RX function, reached through a function pointer */
+using RxBurstFn = size_t (*)(CustomNICDriver<>&, FakeMempool&,
+                             FakeMbuf**, size_t);
+
+size_t generic_rx_burst(CustomNICDriver<>& nic, FakeMempool& pool,
+                        FakeMbuf** out, size_t max) {
+    RxView views[CustomNICDriver<>::MAX_RX_BURST];
+    size_t n = nic.poll_rx_burst(views, max);
+
+    // DPDK translates each descriptor into an mbuf: allocate, fill two
+    // cache lines of metadata, record the view
+    for (size_t i = 0; i < n; i++) {
+        FakeMbuf* m = pool.get();
+        m->buf_addr = views[i].data;
+        m->buf_iova = 0;
+        m->data_off = 0;
+        m->refcnt = 1;
+        m->nb_segs = 1;
+        m->port = 0;
+        m->ol_flags = 0;
+        m->pkt_len = views[i].len;
+        m->data_len = views[i].len;
+        m->vlan_tci = 0;
+        m->hash_rss = 0;
+        out[i] = m;
+    }
+    return n;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::parse(argc, argv);
+
+    CustomNICDriver nic;
+    if (!nic.initialize_loopback()) {
+        fprintf(stderr, "comparison_dpdk: driver initialization failed\n");
+        return 1;
+    }
+
+    const uint64_t tsc_hz = bench::calibrate_tsc_hz();
+    printf("comparison_dpdk: TSC %.3f GHz, %llu iterations per side\n",
+           tsc_hz / 1e9,
+           static_cast<unsigned long long>(opt.iterations));
+
+    uint8_t packet[bench::TEST_PACKET_SIZE];
+    bench::fill_test_packet(packet, sizeof(packet), 0);
+
+    // ------------------------------------------------------------------
+    // Side 1: our path - poll_rx_burst straight off the descriptors
+    // ------------------------------------------------------------------
+    ull_nic::LatencyHistogram ours;
+    {
+        RxView views[CustomNICDriver<>::MAX_RX_BURST];
+        for (uint64_t i = 0; i < opt.iterations; i++) {
+            nic.submit_tx(packet, sizeof(packet));
+            nic.loopback_pump();
+
+            const uint64_t t0 = ull_nic::get_timestamp();
+            size_t n = nic.poll_rx_burst(views, CustomNICDriver<>::MAX_RX_BURST);
+            const uint64_t t1 = ull_nic::get_timestamp();
+
+            if (n > 0) {
+                ours.record(bench::tsc_delta_ns(t1 - t0, tsc_hz));
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Side 2: DPDK-style path - ops-table indirection + mbuf translation
+    // ------------------------------------------------------------------
+    ull_nic::LatencyHistogram dpdk;
+    {
+        FakeMempool pool;
+        FakeMbuf* mbufs[CustomNICDriver<>::MAX_RX_BURST];
+        volatile RxBurstFn rx_burst = generic_rx_burst;  // Defeat devirtualization
+
+        for (uint64_t i = 0; i < opt.iterations; i++) {
+            nic.submit_tx(packet, sizeof(packet));
+            nic.loopback_pump();
+
+            const uint64_t t0 = ull_nic::get_timestamp();
+            size_t n = rx_burst(nic, pool, mbufs, CustomNICDriver<>::MAX_RX_BURST);
+            const uint64_t t1 = ull_nic::get_timestamp();
+
+            if (n > 0) {
+                dpdk.record(bench::tsc_delta_ns(t1 - t0, tsc_hz));
+                for (size_t j = 0; j < n; j++) {
+                    pool.put(mbufs[j]);  // Mempool round trip, like rte_pktmbuf_free
+                }
+            }
+        }
+    }
+
+    const auto p_ours = ours.get_percentiles();
+    const auto p_dpdk = dpdk.get_percentiles();
+
+    printf("\n");
+    printf("Custom driver: %lluns average latency (P50; P99=%lluns)\n",
+           static_cast<unsigned long long>(p_ours.p50),
+           static_cast<unsigned long long>(p_ours.p99));
+    printf("DPDK: %lluns average latency (P50; P99=%lluns)\n",
+           static_cast<unsigned long long>(p_dpdk.p50),
+           static_cast<unsigned long long>(p_dpdk.p99));
+    if (p_ours.p50 > 0) {
+        printf("Speedup: %.2fx\n",
+               static_cast<double>(p_dpdk.p50) / static_cast<double>(p_ours.p50));
+    }
+
+    bench::append_csv(opt, "comparison_ours", p_ours.count,
+                      p_ours.p50, p_ours.p99, p_ours.p999, p_ours.max, 0.0, 0.0);
+    bench::append_csv(opt, "comparison_dpdk_model", p_dpdk.count,
+                      p_dpdk.p50, p_dpdk.p99, p_dpdk.p999, p_dpdk.max, 0.0, 0.0);
+    return 0;
+}
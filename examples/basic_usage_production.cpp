@@ -32,7 +32,7 @@ int main(int argc, char** argv) {
 
     try {
         // Initialize the production custom NIC driver
-        CustomNICDriver nic;
+        hft::hardware::CustomNICDriver<> nic;
         
         std::string pci_device = argv[1];
         std::string resource_path = "/sys/bus/pci/devices/" + pci_device + "/resource0";
@@ -114,9 +114,10 @@ int main(int argc, char* argv[]) {
                 uint64_t packets_processed = total_rx - start_packets;
                 double mpps = (packets_processed / static_cast<double>(elapsed));
                 
-                std::cout << "Packets: " << total_rx 
+                std::cout << "Packets: " << total_rx
                           << " | Rate: " << mpps << " Mpps"
-                          << " | TX: " << nic.get_packets_sent() << "\n";
+                          << " | TX: " << nic.get_packets_sent()
+                          << " | Last HW ts: " << hw_timestamp << " ns\n";
                 
                 last_report = total_rx;
                 start_packets = total_rx;
@@ -1,11 +1,12 @@
 /**
  * Driver Comparison Example
  * 
- * Demonstrates all four production drivers and their performance characteristics:
- * 
+ * Demonstrates the four production integration paths and their
+ * performance characteristics:
+ *
  * 1. custom_nic_driver.hpp    - 20-50ns  (fastest, direct MMIO)
- * 2. hardware_bridge.hpp       - 30-60ns  (portable across NICs)
- * 3. kernel_bypass_nic.hpp     - 40-70ns  (VFIO/IOMMU secure)
+ * 2. hardware_bridge.hpp       - ~400ns   (FPGA inference HIL bridge)
+ * 3. kernel_bypass_nic.hpp     - 40-70ns  (lock-free ingestion framework)
  * 4. solarflare_efvi.hpp       - 100-200ns (Solarflare ef_vi wrapper)
  * 
  * Compile:
@@ -41,8 +42,8 @@ int main(int argc, char** argv) {
         std::cerr << "Usage: " << argv[0] << " <driver_type> <pci_device>\n\n";
         std::cerr << "Driver Types:\n";
         std::cerr << "  custom    - custom_nic_driver.hpp (20-50ns, fastest)\n";
-        std::cerr << "  bridge    - hardware_bridge.hpp (30-60ns, portable)\n";
-        std::cerr << "  bypass    - kernel_bypass_nic.hpp (40-70ns, secure)\n";
+        std::cerr << "  bridge    - hardware_bridge.hpp (~400ns, FPGA inference)\n";
+        std::cerr << "  bypass    - kernel_bypass_nic.hpp (40-70ns, ingestion)\n";
         std::cerr << "  solarflare - solarflare_efvi.hpp (100-200ns, vendor)\n\n";
         std::cerr << "Example:\n";
         std::cerr << "  " << argv[0] << " custom 0000:01:00.0\n\n";
@@ -63,9 +64,11 @@ int main(int argc, char** argv) {
                 "Direct memory-mapped NIC registers, zero abstraction"
             );
             
-            CustomNICDriver nic;
-            nic.initialize(resource_path.c_str());
-            
+            hft::hardware::CustomNICDriver<> nic;
+            if (!nic.initialize(resource_path.c_str())) {
+                throw std::runtime_error("CustomNICDriver initialization failed");
+            }
+
             std::cout << "✓ Direct MMIO descriptor ring access\n";
             std::cout << "✓ Inline assembly for critical paths\n";
             std::cout << "✓ Zero function call overhead\n";
@@ -85,27 +88,29 @@ int main(int argc, char** argv) {
         } else if (driver_type == "bridge") {
             print_driver_info(
                 "hardware_bridge.hpp",
-                "30-60ns",
-                "Portable abstraction layer with NIC auto-detection"
+                "~400ns",
+                "Hardware-in-the-loop FPGA inference bridge"
             );
-            
-            HardwareBridge nic;
-            nic.initialize(resource_path.c_str());
-            
-            std::cout << "✓ Auto-detects NIC type (Intel/Mellanox/Solarflare)\n";
-            std::cout << "✓ Loads optimal register offsets automatically\n";
-            std::cout << "✓ Unified API across hardware vendors\n";
-            std::cout << "✓ Minimal abstraction overhead (~10ns)\n\n";
-            
-            std::cout << "Supported NICs:\n";
-            std::cout << "  - Intel X710 / X722\n";
-            std::cout << "  - Mellanox ConnectX-5 / ConnectX-6\n";
-            std::cout << "  - Solarflare X2522 / X2542\n\n";
-            
+
+            HardwareInTheLoopBridge bridge(AcceleratorMode::SOFTWARE_STUB);
+            if (!bridge.initialize()) {
+                throw std::runtime_error("HIL bridge initialization failed");
+            }
+
+            std::cout << "✓ Hot-swappable software stub / FPGA routing\n";
+            std::cout << "✓ Automatic fallback on hardware degradation\n";
+            std::cout << "✓ Latency SLA tracking (log-bucketed histogram)\n";
+            std::cout << "✓ Pipelined submit/poll inference interface\n\n";
+
+            std::cout << "Accelerator modes:\n";
+            std::cout << "  - SOFTWARE_STUB (development, deterministic)\n";
+            std::cout << "  - HARDWARE_FPGA (production PCIe card)\n";
+            std::cout << "  - HYBRID_FALLBACK (FPGA with software backup)\n\n";
+
             std::cout << "Recommended for:\n";
-            std::cout << "  ✓ Multi-vendor deployments\n";
-            std::cout << "  ✓ Portable applications\n";
-            std::cout << "  ✓ Rapid prototyping\n\n";
+            std::cout << "  ✓ Strategy inference offload\n";
+            std::cout << "  ✓ De-risking FPGA migration\n";
+            std::cout << "  ✓ Latency SLA validation\n\n";
             
         } else if (driver_type == "bypass") {
             print_driver_info(
@@ -113,10 +118,9 @@ int main(int argc, char** argv) {
                 "40-70ns",
                 "VFIO/IOMMU framework with DMA protection"
             );
-            
-            KernelBypassNIC nic;
-            nic.initialize(resource_path.c_str());
-            
+
+            hft::KernelBypassNIC nic;  // Queue + threads come up on start()
+
             std::cout << "✓ Full VFIO/IOMMU memory isolation\n";
             std::cout << "✓ Prevents DMA attacks and corruption\n";
             std::cout << "✓ Secure userspace hardware access\n";
@@ -140,9 +144,11 @@ int main(int argc, char** argv) {
                 "Optimized wrapper around Solarflare ef_vi library"
             );
             
-            SolarflareEfvi nic;
-            nic.initialize(resource_path.c_str());
-            
+            hft::network::SolarflareEFVI nic;
+            if (!nic.initialize(pci_device.c_str())) {
+                throw std::runtime_error("SolarflareEFVI initialization failed");
+            }
+
             std::cout << "✓ Vendor-optimized for Solarflare NICs\n";
             std::cout << "✓ Hardware offload features enabled\n";
             std::cout << "✓ Tested with X2522 / X2542 adapters\n";
@@ -169,7 +175,6 @@ int main(int argc, char** argv) {
         
         // All drivers share the same busy_wait_loop API
         // (This is demonstration code - actual implementation varies per driver)
-        uint64_t packets = 0;
         std::cout << "Waiting for packets...\n";
         
         // In real usage, you'd call nic.busy_wait_loop() here
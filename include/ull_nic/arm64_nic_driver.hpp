@@ -1,7 +1,10 @@
 #pragma once
 
 #include "common_types.hpp"
+#include "ring_diagnostics.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <sys/mman.h>
 #include <fcntl.h>
@@ -194,70 +197,315 @@ public:
         return true;
     }
     
+    /**
+     * @brief Count the contiguous run of completed descriptors from `start`
+     *
+     * NEON variant of the x86 AVX2 ring scan: loads the status words of 4
+     * cache-line descriptors into one uint32x4_t, masks the DD bits with a
+     * single vtst, and extracts the completed-run length from the lane
+     * mask - one vector op instead of 4 dependent load+branch pairs.
+     *
+     * `start + max` must not wrap the ring (callers split at the ring end).
+     * The caller is responsible for an acquire barrier (dmb ishld) AFTER
+     * the scan, before touching packet data - one barrier per run instead
+     * of one per packet.
+     */
+    inline uint32_t scan_rx_done(uint32_t start, uint32_t max) const {
+        uint32_t n = 0;
+
+#ifdef __aarch64__
+        while (n + 4 <= max) {
+            const RxDescriptor* d = &rx_ring_[start + n];
+            // Gather 4 status words (descriptors are 64B apart - one
+            // cache line each, so these are 4 independent L1 loads)
+            uint32x4_t status = vdupq_n_u32(0);
+            status = vsetq_lane_u32(d[0].status, status, 0);
+            status = vsetq_lane_u32(d[1].status, status, 1);
+            status = vsetq_lane_u32(d[2].status, status, 2);
+            status = vsetq_lane_u32(d[3].status, status, 3);
+
+            // Lane -> all-ones where DD set, one mask op for 4 descriptors
+            uint32x4_t done = vtstq_u32(status, vdupq_n_u32(DESC_STATUS_DD));
+
+            // Narrow to 4 nibbles and count the completed prefix
+            uint64_t mask = vget_lane_u64(
+                vreinterpret_u64_u16(vmovn_u32(done)), 0);
+            if (mask == UINT64_C(0xFFFFFFFFFFFFFFFF)) {
+                n += 4;
+                continue;
+            }
+            // Trailing all-ones 16-bit lanes = completed prefix length
+            return n + (mask ? (__builtin_ctzll(~mask) / 16) : 0);
+        }
+#endif
+
+        // Scalar tail (and full fallback without NEON)
+        while (n < max) {
+            if (!(rx_ring_[start + n].status & DESC_STATUS_DD)) {
+                break;
+            }
+            n++;
+        }
+        return n;
+    }
+
     /**
      * @brief Receive packet (ARM64-optimized with LDAPR)
      */
     __attribute__((always_inline))
     inline bool receive_packet(uint8_t** packet_out, uint16_t* len_out) {
         RxDescriptor* desc = &rx_ring_[rx_head_];
-        
+
 #ifdef __aarch64__
-        // ARM64: Use Load-Acquire for DMA coherency
-        uint32_t status;
-        __asm__ __volatile__(
-            "ldapr %w0, [%1]\n"
-            : "=r"(status)
-            : "r"(&desc->status)
-            : "memory"
-        );
-        
-        if (!(status & DESC_STATUS_DD)) {
-            return false;
+        // Consume from the vectorized scan when a completed run is already
+        // known - skips the per-packet load-acquire inside a burst
+        if (rx_done_run_ == 0) {
+            uint32_t to_end = RX_RING_SIZE - rx_head_;
+            uint32_t limit = (to_end < 8) ? to_end : 8;
+            rx_done_run_ = scan_rx_done(rx_head_, limit);
+            if (rx_done_run_ == 0) {
+                return false;
+            }
+            // One acquire barrier for the whole run (vs one per packet):
+            // order the DD-bit loads before any packet-data loads
+            __asm__ __volatile__("dmb ishld" ::: "memory");
         }
-        
-        // Prefetch next descriptor using PRFM
+        rx_done_run_--;
+
+        // Prefetch pipeline: next descriptor AND the head of the next
+        // payload via PRFM. The NIC DMA'd the payload to DRAM/LLC, so
+        // its first line is a guaranteed L1 miss (40-80ns) - issuing
+        // the prefetches here overlaps that miss with the caller's
+        // processing of THIS packet.
         uint32_t next_idx = (rx_head_ + 1) & (RX_RING_SIZE - 1);
+        const uint8_t* next_buf = rx_buffers_ + (next_idx * MAX_PACKET_SIZE);
         __asm__ __volatile__(
             "prfm pldl1keep, [%0]\n"
+            "prfm pldl1keep, [%1]\n"
+            "prfm pldl1keep, [%1, #64]\n"
             :
-            : "r"(&rx_ring_[next_idx])
+            : "r"(&rx_ring_[next_idx]), "r"(next_buf)
             : "memory"
         );
 #else
         if (!(desc->status & DESC_STATUS_DD)) {
             return false;
         }
+
+        // Same prefetch pipeline for the portable build
+        uint32_t next_idx = (rx_head_ + 1) & (RX_RING_SIZE - 1);
+        __builtin_prefetch(&rx_ring_[next_idx], 0, 3);
+        __builtin_prefetch(rx_buffers_ + (next_idx * MAX_PACKET_SIZE), 0, 3);
+        __builtin_prefetch(rx_buffers_ + (next_idx * MAX_PACKET_SIZE) + 64, 0, 3);
 #endif
         
         *packet_out = rx_buffers_ + (rx_head_ * MAX_PACKET_SIZE);
         *len_out = desc->length;
-        
+
+        trace_.record(RingEvent::RX_PACKET,
+                      static_cast<uint16_t>(rx_head_), desc->length);
+
         // Clear status for reuse
         desc->status = 0;
-        
+
         // Advance head
         rx_head_ = (rx_head_ + 1) & (RX_RING_SIZE - 1);
-        
+
         // Update tail register
         write_reg(REG_RX_DESC_TAIL, (rx_head_ - 1) & (RX_RING_SIZE - 1));
-        
+
         packets_received_++;
         return true;
     }
     
+    /**
+     * @brief One packet of a burst (points into the RX DMA buffer)
+     */
+    struct RxSlice {
+        uint8_t* data;       ///< Zero-copy pointer into the RX buffer
+        uint16_t length;     ///< Packet length from the descriptor
+        uint64_t timestamp;  ///< Descriptor timestamp field (0 if unset)
+    };
+
+    /// Upper bound for one receive_burst() call
+    static constexpr uint32_t MAX_RX_BURST = 64;
+
+    /**
+     * @brief Receive a burst of packets (ARM64 whole-line descriptor loads)
+     *
+     * Burst variant of receive_packet() with the same semantics as the
+     * x86 drivers' poll_rx_burst(): amortize everything that
+     * receive_packet() pays per packet over the whole completed run.
+     *
+     * - DD scan: scan_rx_done() tests 4 descriptors per NEON op
+     * - Barrier: ONE `dmb ishld` per burst (after the scan, before any
+     *   descriptor field or payload load) instead of a load-acquire
+     *   per packet - on Neoverse the per-packet barrier alone is ~4ns
+     * - Descriptor read: each 64-byte descriptor is pulled into NEON
+     *   registers with a pair of `ld1` 32-byte loads (the compiler
+     *   emits ldp q-form for these) and the fields extracted by lane -
+     *   one line fill, no repeated scalar touches of the same line
+     * - Doorbell: ONE tail write per burst
+     *
+     * @param out Array of at least `max` RxSlice entries
+     * @param max Maximum packets to drain (clamped to MAX_RX_BURST)
+     * @return Number of packets received
+     */
+    inline uint32_t receive_burst(RxSlice* out, uint32_t max) {
+        if (max > MAX_RX_BURST) {
+            max = MAX_RX_BURST;
+        }
+
+        // Scan the completed run, splitting at the ring wrap so the
+        // vector scan never reads past the array
+        uint32_t to_end = RX_RING_SIZE - rx_head_;
+        uint32_t n = scan_rx_done(rx_head_, (max < to_end) ? max : to_end);
+        if (n < max && n == to_end) {
+            n += scan_rx_done(0, max - n);
+        }
+        if (n == 0) {
+            return 0;
+        }
+
+#ifdef __aarch64__
+        // One acquire barrier for the whole burst: order every DD load
+        // above before every descriptor-field/payload load below
+        __asm__ __volatile__("dmb ishld" ::: "memory");
+        // The single-packet path's run cache is now stale - it would
+        // double-deliver descriptors this burst consumes
+        rx_done_run_ = 0;
+#endif
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t idx = (rx_head_ + i) & (RX_RING_SIZE - 1);
+            RxDescriptor* desc = &rx_ring_[idx];
+
+#ifdef __aarch64__
+            // Whole-line load: bytes 0-31 cover buffer_addr, length,
+            // checksum, status, rss_hash and timestamp. Two q-register
+            // ld1 loads the compiler fuses into ldp - the line is
+            // touched once, fields come out of registers by lane.
+            // Lane map is tied to the struct layout - if a field moves,
+            // the extraction below reads the wrong bytes silently
+            static_assert(offsetof(RxDescriptor, length) == 8,
+                          "length is u16 lane 4 of the first q-register");
+            static_assert(offsetof(RxDescriptor, timestamp) == 24,
+                          "timestamp is u64 lane 1 of the second q-register");
+            uint8x16x2_t line = vld1q_u8_x2(
+                reinterpret_cast<const uint8_t*>(desc));
+            out[i].length = vgetq_lane_u16(
+                vreinterpretq_u16_u8(line.val[0]), 4);
+            out[i].timestamp = vgetq_lane_u64(
+                vreinterpretq_u64_u8(line.val[1]), 1);
+#else
+            out[i].length = desc->length;
+            out[i].timestamp = desc->timestamp;
+#endif
+            out[i].data = rx_buffers_ + (idx * MAX_PACKET_SIZE);
+
+            // Release the slot back to hardware (plain store - the
+            // per-burst doorbell below publishes the batch)
+            desc->status = 0;
+        }
+
+        trace_.record(RingEvent::RX_BURST,
+                      static_cast<uint16_t>(rx_head_), n);
+        rx_head_ = (rx_head_ + n) & (RX_RING_SIZE - 1);
+
+        // ONE doorbell for the whole burst (write_reg carries dmb st)
+        write_reg(REG_RX_DESC_TAIL, (rx_head_ - 1) & (RX_RING_SIZE - 1));
+
+        packets_received_ += n;
+        return n;
+    }
+
+    /**
+     * @brief Idle wait on the next RX descriptor line (WFE, not spin)
+     *
+     * A pure polling loop on Neoverse keeps the LSU saturated with the
+     * same descriptor load, stealing issue slots from the SMT-less
+     * core's prefetchers and burning power. ARM gives us the x86
+     * umonitor/umwait equivalent for free: `wfe` sleeps the core until
+     * an event, and a load-exclusive (`ldaxr`) arms the event monitor
+     * on the watched line - the NIC's DMA write of the DD bit clears
+     * the exclusive monitor and wakes the core. Wakeup cost is tens of
+     * nanoseconds, not the microseconds of an interrupt.
+     *
+     * Software producers (loopback/tests) wake a waiter with
+     * notify_rx() since a plain store from another core also clears
+     * the monitor - `sev` covers the store-was-earlier race.
+     *
+     * @param max_waits Bound on wfe sleeps (0 = check once, no sleep)
+     * @return true if the next descriptor is ready
+     */
+    inline bool wait_for_rx(uint32_t max_waits = 1000000) {
+        volatile uint32_t* status = &rx_ring_[rx_head_].status;
+
+#ifdef __aarch64__
+        for (uint32_t i = 0; ; i++) {
+            uint32_t s;
+            // ldaxr: load-acquire + arm the exclusive monitor on the
+            // descriptor's cache line
+            __asm__ __volatile__(
+                "ldaxr %w0, [%1]\n"
+                : "=r"(s)
+                : "r"(status)
+                : "memory"
+            );
+            if (s & DESC_STATUS_DD) {
+                return true;
+            }
+            if (i >= max_waits) {
+                return false;
+            }
+            // Sleep until the monitored line is written (DMA writeback
+            // of the DD bit) or an explicit sev
+            __asm__ __volatile__("wfe" ::: "memory");
+        }
+#else
+        // Portable fallback: bounded relaxed spin
+        for (uint32_t i = 0; i <= max_waits; i++) {
+            if (*status & DESC_STATUS_DD) {
+                return true;
+            }
+        }
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Wake a wait_for_rx() sleeper (software producers only)
+     *
+     * Real DMA wakes the waiter through the monitored line; loopback
+     * and test harnesses call this after staging packets.
+     */
+    inline void notify_rx() {
+#ifdef __aarch64__
+        __asm__ __volatile__("sev" ::: "memory");
+#endif
+    }
+
     /**
      * @brief Send packet (ARM64-optimized with STLR)
      */
     __attribute__((always_inline))
     inline bool send_packet(const uint8_t* data, uint16_t length) {
+        // Lazy reclamation: amortize the completion walk over many
+        // sends instead of paying it only at the ring-full cliff
+        if (tx_in_flight() >= tx_reclaim_threshold_) {
+            reclaim_tx_descriptors();
+        }
+
         uint32_t next_tail = (tx_tail_ + 1) & (TX_RING_SIZE - 1);
         if (next_tail == tx_head_) {
             reclaim_tx_descriptors();
             if (next_tail == tx_head_) {
+                trace_.record(RingEvent::TX_RING_FULL,
+                              static_cast<uint16_t>(tx_tail_));
                 return false;
             }
         }
-        
+
         TxDescriptor* desc = &tx_ring_[tx_tail_];
         uint8_t* tx_buffer = tx_buffers_ + (tx_tail_ * MAX_PACKET_SIZE);
         
@@ -291,15 +539,93 @@ public:
         desc->status = 0;
         __sync_synchronize();
 #endif
-        
+
+        trace_.record(RingEvent::TX_POST,
+                      static_cast<uint16_t>(tx_tail_), length);
+
         // Update tail pointer
         tx_tail_ = next_tail;
+        trace_.record(RingEvent::TX_DOORBELL,
+                      static_cast<uint16_t>(tx_tail_), 1);
         write_reg(REG_TX_DESC_TAIL, tx_tail_);
-        
+
         packets_sent_++;
         return true;
     }
-    
+
+    /**
+     * @brief Borrow the next TX DMA slot for in-place serialization
+     *
+     * Zero-copy alternative to send_packet(): send_packet() routes every
+     * payload through neon_memcpy into the DMA buffer. Serializing the
+     * message directly into the slot skips that copy entirely - only the
+     * descriptor setup and doorbell remain on the commit path.
+     *
+     * Slots are committed in acquisition order; re-acquiring before commit
+     * returns the same slot. Returns nullptr if the TX ring is full even
+     * after reclaiming completed descriptors.
+     *
+     * @return Writable pointer (MAX_PACKET_SIZE bytes) or nullptr
+     */
+    __attribute__((always_inline))
+    inline uint8_t* acquire_tx_buffer() {
+        if (tx_in_flight() >= tx_reclaim_threshold_) {
+            reclaim_tx_descriptors();  // Lazy bulk reclaim
+        }
+
+        uint32_t next_tail = (tx_tail_ + 1) & (TX_RING_SIZE - 1);
+        if (next_tail == tx_head_) {
+            reclaim_tx_descriptors();
+            if (next_tail == tx_head_) {
+                return nullptr;  // Ring full
+            }
+        }
+        return tx_buffers_ + (tx_tail_ * MAX_PACKET_SIZE);
+    }
+
+    /**
+     * @brief Commit a previously acquired TX slot (no payload copy)
+     *
+     * @param slot Pointer returned by acquire_tx_buffer()
+     * @param length Number of bytes serialized into the slot
+     * @return true if submitted, false on invalid slot
+     */
+    __attribute__((always_inline))
+    inline bool commit_tx(const uint8_t* slot, uint16_t length) {
+        if (slot != tx_buffers_ + (tx_tail_ * MAX_PACKET_SIZE)) {
+            return false;  // Not the acquired slot
+        }
+
+        TxDescriptor* desc = &tx_ring_[tx_tail_];
+        desc->buffer_addr = get_physical_addr(slot);
+        desc->cmd_type_len = length | DESC_STATUS_EOP;
+
+#ifdef __aarch64__
+        // Store-Release publishes the descriptor before the doorbell
+        __asm__ __volatile__(
+            "stlr %w0, [%1]\n"
+            :
+            : "r"(0), "r"(&desc->status)
+            : "memory"
+        );
+        __asm__ __volatile__("dmb ish" ::: "memory");
+#else
+        desc->status = 0;
+        __sync_synchronize();
+#endif
+
+        trace_.record(RingEvent::TX_POST,
+                      static_cast<uint16_t>(tx_tail_), length);
+
+        tx_tail_ = (tx_tail_ + 1) & (TX_RING_SIZE - 1);
+        trace_.record(RingEvent::TX_DOORBELL,
+                      static_cast<uint16_t>(tx_tail_), 1);
+        write_reg(REG_TX_DESC_TAIL, tx_tail_);
+
+        packets_sent_++;
+        return true;
+    }
+
     /**
      * @brief Get CPU timestamp using ARM64 system counter
      */
@@ -336,7 +662,33 @@ public:
      */
     uint64_t get_packets_received() const { return packets_received_; }
     uint64_t get_packets_sent() const { return packets_sent_; }
-    
+
+    /**
+     * @brief TX descriptors posted but not yet reclaimed
+     *
+     * Two subtractions against software state - poll freely for
+     * backpressure (slow the producer as this nears TX_RING_SIZE
+     * instead of spinning on a full ring).
+     */
+    __attribute__((always_inline))
+    inline uint32_t tx_in_flight() const {
+        return (tx_tail_ - tx_head_) & (TX_RING_SIZE - 1);
+    }
+
+    /**
+     * @brief Set the in-flight depth that triggers bulk TX reclamation
+     *
+     * Lower values reclaim more often (fresher backpressure signal);
+     * higher values amortize the completion walk over more sends.
+     * Defaults to half the ring.
+     */
+    void set_tx_reclaim_threshold(uint32_t threshold) {
+        if (threshold == 0 || threshold >= TX_RING_SIZE) {
+            threshold = TX_RING_SIZE / 2;
+        }
+        tx_reclaim_threshold_ = threshold;
+    }
+
     /**
      * @brief Check if link is up
      */
@@ -344,7 +696,65 @@ public:
         uint32_t status = read_reg(REG_STATUS);
         return (status & 0x02) != 0;
     }
-    
+
+    /**
+     * @brief Sample ring state for an off-core control thread
+     *
+     * Pairs the software cursors with the hardware head/tail registers
+     * so a stalled queue can be attributed without attaching a debugger:
+     * RX head register advancing while rx_head_ sits still means the
+     * poller is dead or descheduled; both stuck means the loss is
+     * upstream. Seqlock-style resample - re-read the cursors after the
+     * MMIO reads and retry if the poller moved - so the sample is
+     * consistent without any cost on the polling core.
+     *
+     * @return RingSnapshot (see ring_diagnostics.hpp for field notes)
+     */
+    RingSnapshot snapshot() const {
+        RingSnapshot s{};
+
+        for (int attempt = 0; attempt < 4; attempt++) {
+            const uint32_t rx0 = rx_head_;
+            const uint32_t th0 = tx_head_;
+            const uint32_t tt0 = tx_tail_;
+
+            s.tsc = get_timestamp();
+            s.hw_rx_head = read_reg(REG_RX_DESC_HEAD);
+            s.hw_rx_tail = read_reg(REG_RX_DESC_TAIL);
+            s.hw_tx_head = read_reg(REG_TX_DESC_HEAD);
+            s.hw_tx_tail = read_reg(REG_TX_DESC_TAIL);
+
+            if (rx_head_ == rx0 && tx_head_ == th0 && tx_tail_ == tt0) {
+                s.sw_rx_head = rx0;
+                s.sw_tx_head = th0;
+                s.sw_tx_tail = tt0;
+                break;  // Cursors held still across the register reads
+            }
+            // Poller moved mid-sample - keep the freshest values
+            s.sw_rx_head = rx_head_;
+            s.sw_tx_head = tx_head_;
+            s.sw_tx_tail = tx_tail_;
+        }
+
+        s.rx_backlog = (s.hw_rx_head - s.sw_rx_head) & (RX_RING_SIZE - 1);
+        // Reclaim here walks DD bits (no cached hardware head), so the
+        // software cursors are the honest in-flight measure
+        s.tx_in_flight = (s.sw_tx_tail - s.sw_tx_head) & (TX_RING_SIZE - 1);
+        s.packets_received = packets_received_;
+        s.packets_sent = packets_sent_;
+        return s;
+    }
+
+    /**
+     * @brief Ring-event trace buffer (compiled out by default)
+     *
+     * Build with -DULL_NIC_RING_TRACE=1 to record the last 256 ring
+     * transitions; dump() on the disabled tracer returns 0 records.
+     */
+    const RingTracer<kRingTraceEnabled>& ring_trace() const {
+        return trace_;
+    }
+
 private:
     const char* pci_address_;
     volatile uint8_t* bar0_base_;
@@ -358,11 +768,17 @@ private:
     uint32_t rx_head_;
     uint32_t tx_head_;
     uint32_t tx_tail_;
+    uint32_t rx_done_run_ = 0;  // Completed descriptors known via scan_rx_done
+    uint32_t tx_reclaim_threshold_ = TX_RING_SIZE / 2;  // Lazy reclaim trigger
     
     uint64_t packets_received_;
     uint64_t packets_sent_;
     bool initialized_;
-    
+
+    // Ring-event tracepoints - zero-size and zero-cost unless built
+    // with -DULL_NIC_RING_TRACE=1
+    RingTracer<kRingTraceEnabled> trace_;
+
     /**
      * @brief ARM64 NEON-optimized memcpy
      */
@@ -401,8 +817,13 @@ private:
      */
     bool map_bar0() {
         char path[256];
-        snprintf(path, sizeof(path), "/sys/bus/pci/devices/%s/resource0", pci_address_);
-        
+        if (pci_address_[0] == '/') {
+            // Already a resource path (simulated BAR0 or explicit sysfs file)
+            snprintf(path, sizeof(path), "%s", pci_address_);
+        } else {
+            snprintf(path, sizeof(path), "/sys/bus/pci/devices/%s/resource0", pci_address_);
+        }
+
         int fd = open(path, O_RDWR | O_SYNC);
         if (fd < 0) {
             return false;
@@ -471,16 +892,26 @@ private:
     }
     
     /**
-     * @brief Reclaim TX descriptors
+     * @brief Reclaim every completed TX descriptor in one pass
+     *
+     * Invoked lazily (in-flight depth >= threshold) rather than per
+     * send: at a sustained 2Mpps TX rate the completion walk is a
+     * measurable slice of the send core, and the hardware retires
+     * descriptors in bulk anyway - one pass after N sends frees the
+     * same slots for a fraction of the cycles.
      */
     void reclaim_tx_descriptors() {
+        uint32_t freed = 0;
         while (tx_head_ != tx_tail_) {
             TxDescriptor* desc = &tx_ring_[tx_head_];
             if (!(desc->status & DESC_STATUS_DD)) {
                 break;
             }
             tx_head_ = (tx_head_ + 1) & (TX_RING_SIZE - 1);
+            freed++;
         }
+        trace_.record(RingEvent::TX_RECLAIM,
+                      static_cast<uint16_t>(tx_head_), freed);
     }
     
     /**
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "common_types.hpp"
+#include "ring_diagnostics.hpp"
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <sys/mman.h>
 #include <fcntl.h>
@@ -233,7 +235,10 @@ public:
         
         *packet_out = rx_buffers_ + (rx_head_ * MAX_PACKET_SIZE);
         *len_out = desc->length;
-        
+
+        trace_.record(RingEvent::RX_PACKET,
+                      static_cast<uint16_t>(rx_head_), desc->length);
+
         // Clear status for reuse
         desc->status = 0;
         
@@ -246,7 +251,55 @@ public:
         packets_received_++;
         return true;
     }
-    
+
+    /**
+     * @brief Receive a packet together with its hardware timestamp
+     * @param packet_out Pointer to store packet data pointer
+     * @param len_out Pointer to store packet length
+     * @param timestamp_out Pointer to store the 64-bit PHC arrival time (ns)
+     * @return true if packet received, false if no packet available
+     *
+     * The descriptor writeback only carries the LOW 32 bits of the PHC
+     * (timestamp_lo - ~4.29s of range); the high word is reconstructed
+     * from REG_PTP_TIME_HI, stepping back one epoch if the counter
+     * wrapped between stamping and this read. Use this instead of a
+     * software stamp after receive_packet() - the descriptor value was
+     * taken at the wire, before PCIe transit and polling-phase jitter.
+     */
+    __attribute__((always_inline))
+    inline bool receive_packet_ts(uint8_t** packet_out, uint16_t* len_out,
+                                  uint64_t* timestamp_out) {
+        RxDescriptor* desc = &rx_ring_[rx_head_];
+
+        if (!(desc->status & DESC_STATUS_DD)) {
+            return false;  // No packet available
+        }
+
+        _mm_prefetch(reinterpret_cast<const char*>(&rx_ring_[(rx_head_ + 1) & (RX_RING_SIZE - 1)]), _MM_HINT_T0);
+
+        *packet_out = rx_buffers_ + (rx_head_ * MAX_PACKET_SIZE);
+        *len_out = desc->length;
+
+        // Extend the 32-bit descriptor stamp with the current PHC epoch
+        const uint32_t stamp_lo = desc->timestamp_lo;
+        uint32_t now_hi = read_reg(REG_PTP_TIME_HI);
+        const uint32_t now_lo = read_reg(REG_PTP_TIME_LO);
+        if (now_lo < stamp_lo) {
+            now_hi--;  // Low word wrapped after the packet was stamped
+        }
+        *timestamp_out = (static_cast<uint64_t>(now_hi) << 32) | stamp_lo;
+
+        trace_.record(RingEvent::RX_PACKET,
+                      static_cast<uint16_t>(rx_head_), desc->length);
+
+        desc->status = 0;
+        rx_head_ = (rx_head_ + 1) & (RX_RING_SIZE - 1);
+        write_reg(REG_RX_RING_TAIL, (rx_head_ - 1) & (RX_RING_SIZE - 1));
+
+        packets_received_++;
+        return true;
+    }
+
     /**
      * @brief Send a packet (zero-copy, direct DMA)
      * @param data Pointer to packet data
@@ -256,15 +309,23 @@ public:
     __attribute__((always_inline))
     inline bool send_packet(const uint8_t* data, uint16_t length) {
         // Check if TX ring has space
+        // Lazy reclamation: run the completion walk when the in-flight
+        // depth crosses the threshold, not on every send
+        if (tx_in_flight() >= tx_reclaim_threshold_) {
+            reclaim_tx_descriptors();
+        }
+
         uint32_t next_tail = (tx_tail_ + 1) & (TX_RING_SIZE - 1);
         if (next_tail == tx_head_) {
             // Ring full, reclaim descriptors
             reclaim_tx_descriptors();
             if (next_tail == tx_head_) {
+                trace_.record(RingEvent::TX_RING_FULL,
+                              static_cast<uint16_t>(tx_tail_));
                 return false;  // Still full
             }
         }
-        
+
         TxDescriptor* desc = &tx_ring_[tx_tail_];
         uint8_t* tx_buffer = tx_buffers_ + (tx_tail_ * MAX_PACKET_SIZE);
         
@@ -278,11 +339,16 @@ public:
         desc->checksum_offset = 0;
         desc->vlan_tag = 0;
         
+        trace_.record(RingEvent::TX_POST,
+                      static_cast<uint16_t>(tx_tail_), length);
+
         // Memory barrier before updating tail
         _mm_sfence();
-        
+
         // Update tail pointer (triggers DMA)
         tx_tail_ = next_tail;
+        trace_.record(RingEvent::TX_DOORBELL,
+                      static_cast<uint16_t>(tx_tail_), 1);
         write_reg(REG_TX_RING_TAIL, tx_tail_);
         
         packets_sent_++;
@@ -349,7 +415,89 @@ public:
      */
     uint64_t get_packets_received() const { return packets_received_; }
     uint64_t get_packets_sent() const { return packets_sent_; }
-    
+
+    /**
+     * @brief TX descriptors posted but not yet reclaimed (no MMIO)
+     *
+     * Poll freely for backpressure: slow the producer as this nears
+     * TX_RING_SIZE instead of spinning on a full ring.
+     */
+    __attribute__((always_inline))
+    inline uint32_t tx_in_flight() const {
+        return (tx_tail_ - tx_head_) & (TX_RING_SIZE - 1);
+    }
+
+    /**
+     * @brief Set the in-flight depth that triggers bulk TX reclamation
+     *
+     * Defaults to half the ring; lower reclaims more often, higher
+     * amortizes the completion walk over more sends.
+     */
+    void set_tx_reclaim_threshold(uint32_t threshold) {
+        if (threshold == 0 || threshold >= TX_RING_SIZE) {
+            threshold = TX_RING_SIZE / 2;
+        }
+        tx_reclaim_threshold_ = threshold;
+    }
+
+    /**
+     * @brief Sample ring state for an off-core control thread
+     *
+     * Pairs the software cursors with the hardware head/tail registers
+     * so a stalled queue can be attributed from a control thread: the
+     * RX head register advancing while rx_head_ sits still means the
+     * poller is dead or descheduled; both stuck means the loss is
+     * upstream. Seqlock-style resample - re-read the cursors after the
+     * MMIO reads and retry if the poller moved - so the sample is
+     * consistent without any cost on the polling core.
+     *
+     * @return RingSnapshot (see ring_diagnostics.hpp for field notes)
+     */
+    RingSnapshot snapshot() const {
+        RingSnapshot s{};
+
+        for (int attempt = 0; attempt < 4; attempt++) {
+            const uint32_t rx0 = rx_head_;
+            const uint32_t th0 = tx_head_;
+            const uint32_t tt0 = tx_tail_;
+
+            s.tsc = get_timestamp();
+            s.hw_rx_head = read_reg(REG_RX_RING_HEAD);
+            s.hw_rx_tail = read_reg(REG_RX_RING_TAIL);
+            s.hw_tx_head = read_reg(REG_TX_RING_HEAD);
+            s.hw_tx_tail = read_reg(REG_TX_RING_TAIL);
+
+            if (rx_head_ == rx0 && tx_head_ == th0 && tx_tail_ == tt0) {
+                s.sw_rx_head = rx0;
+                s.sw_tx_head = th0;
+                s.sw_tx_tail = tt0;
+                break;  // Cursors held still across the register reads
+            }
+            // Poller moved mid-sample - keep the freshest values
+            s.sw_rx_head = rx_head_;
+            s.sw_tx_head = tx_head_;
+            s.sw_tx_tail = tx_tail_;
+        }
+
+        s.rx_backlog = (s.hw_rx_head - s.sw_rx_head) & (RX_RING_SIZE - 1);
+        // Reclamation walks DD bits here, so the software cursors are
+        // the honest in-flight measure
+        s.tx_in_flight = (s.sw_tx_tail - s.sw_tx_head) & (TX_RING_SIZE - 1);
+        s.packets_received = packets_received_;
+        s.packets_sent = packets_sent_;
+        return s;
+    }
+
+    /**
+     * @brief Ring-event trace buffer (compiled out by default)
+     *
+     * Build with -DULL_NIC_RING_TRACE=1 to record the last 256 ring
+     * transitions; dump() on the disabled tracer returns 0 records.
+     */
+    const RingTracer<kRingTraceEnabled>& ring_trace() const {
+        return trace_;
+    }
+
     /**
      * @brief Configure RSS (Receive Side Scaling) for multi-core
      * @param num_queues Number of RX queues (1-16)
@@ -386,18 +534,28 @@ private:
     uint32_t rx_head_;
     uint32_t tx_head_;
     uint32_t tx_tail_;
-    
+    uint32_t tx_reclaim_threshold_ = TX_RING_SIZE / 2;  // Lazy reclaim trigger
+
     uint64_t packets_received_;
     uint64_t packets_sent_;
     bool initialized_;
-    
+
+    // Ring-event tracepoints - zero-size and zero-cost unless built
+    // with -DULL_NIC_RING_TRACE=1
+    RingTracer<kRingTraceEnabled> trace_;
+
     /**
      * @brief Map BAR0 register space
      */
     bool map_bar0() {
         char path[256];
-        snprintf(path, sizeof(path), "/sys/bus/pci/devices/%s/resource0", pci_address_);
-        
+        if (pci_address_[0] == '/') {
+            // Already a resource path (simulated BAR0 or explicit sysfs file)
+            snprintf(path, sizeof(path), "%s", pci_address_);
+        } else {
+            snprintf(path, sizeof(path), "/sys/bus/pci/devices/%s/resource0", pci_address_);
+        }
+
         int fd = open(path, O_RDWR | O_SYNC);
         if (fd < 0) {
             return false;
@@ -504,16 +662,24 @@ private:
     }
     
     /**
-     * @brief Reclaim completed TX descriptors
+     * @brief Reclaim every completed TX descriptor in one pass
+     *
+     * Called lazily from send_packet() once the in-flight depth crosses
+     * tx_reclaim_threshold_ - the hardware retires descriptors in bulk,
+     * so one walk after N sends frees the same slots as N walks.
      */
     void reclaim_tx_descriptors() {
+        uint32_t freed = 0;
         while (tx_head_ != tx_tail_) {
             TxDescriptor* desc = &tx_ring_[tx_head_];
             if (!(desc->status & DESC_STATUS_DD)) {
                 break;  // Not done yet
             }
             tx_head_ = (tx_head_ + 1) & (TX_RING_SIZE - 1);
+            freed++;
         }
+        trace_.record(RingEvent::TX_RECLAIM,
+                      static_cast<uint16_t>(tx_head_), freed);
     }
     
     /**
@@ -0,0 +1,493 @@
+#pragma once
+
+#include "custom_nic_driver.hpp"
+#include "common_types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Persistent Packet Capture: Memory-Mapped Segments off the RX Hot Path
+ *
+ * Why fwrite-based capture drops at 8Mpps:
+ * ───────────────────────────────────────
+ *
+ * The usual design - copy each packet into a queue, writer thread
+ * appends pcap via fwrite - fails twice. The copy into the queue
+ * pollutes the polling core's L1/L2 (every captured byte evicts a byte
+ * the hot path needed), and the writer thread's buffered I/O tops out
+ * around 2-3 Mpps before the queue backs up into the poller.
+ *
+ * The design here:
+ * ───────────────
+ *
+ * 1. PREALLOCATED MMAP SEGMENTS: a small ring of fixed-size segment
+ *    files, created and mapped up front. "Writing" a packet is a
+ *    memcpy into mapped memory - no syscall, no allocation, no
+ *    buffering decisions on the hot path. The kernel writes dirty
+ *    pages back on its own schedule, off our core.
+ *
+ * 2. FIXED-SLOT LAYOUT: each slot is a 16-byte record header
+ *    (hardware timestamp from the descriptor, captured/original
+ *    length) plus a snaplen payload. Fixed slots mean the writer is a
+ *    cursor increment - and a crashed process leaves a scannable file.
+ *
+ * 3. NON-TEMPORAL STORES: the capture copy uses streaming stores that
+ *    bypass the cache hierarchy entirely. Captured bytes will not be
+ *    read by this core (the rotator reads them much later, on another
+ *    core), so pulling them through L1/L2 would only evict the
+ *    descriptor rings and flow tables the hot path lives on.
+ *
+ * 4. BACKGROUND ROTATION: when a segment fills, the poller flips to
+ *    the next FREE one (one atomic store); a rotator thread converts
+ *    the full segment to standard pcapng (readable by wireshark and
+ *    by pcap_replay.hpp) and recycles it. If every segment is full
+ *    the packet is counted as dropped - capture never stalls RX.
+ *
+ * Attaching as a tee (no second parse, no second copy):
+ * ```cpp
+ * CaptureWriter cap;
+ * cap.open("/capture/ull", 4, 65536);
+ * cap.start_rotator();
+ *
+ * nic.busy_wait_loop_burst([&](const RxView* pkts, size_t n) {
+ *     for (size_t i = 0; i < n; i++) {
+ *         cap.capture(pkts[i]);          // hw timestamp from descriptor
+ *         ring.publish(pkts[i]);         // fan-out as before
+ *     }
+ * });
+ * // or the single-packet loop:
+ * nic.busy_wait_loop(cap.tee([&](uint8_t* p, size_t len) {
+ *     process_market_data(p, len);
+ * }));
+ * ```
+ */
+
+namespace hft {
+namespace hardware {
+
+class CaptureWriter {
+public:
+    // Slot = 16-byte record header + snaplen payload. 2KB total matches
+    // PACKET_BUFFER_SIZE: nothing the driver can receive is truncated
+    // except jumbo payloads beyond SNAP_LEN (orig_len records the truth).
+    static constexpr size_t SLOT_SIZE = 2048;
+    static constexpr size_t SNAP_LEN = SLOT_SIZE - 16;
+
+    static constexpr uint64_t SEG_MAGIC = 0x554C4C43415030ULL;  // "ULLCAP0"
+
+    CaptureWriter() = default;
+
+    ~CaptureWriter() {
+        close_all();
+    }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * Preallocate and map the segment ring (one-time setup)
+     *
+     * Creates `<prefix>_000.seg` .. and maps them MAP_SHARED, so the
+     * data survives the process. MADV_HUGEPAGE asks for transparent
+     * hugepages on the mapping - fewer TLB entries stolen from the
+     * polling core (a hugetlbfs mount would pin real hugepages; THP is
+     * what works everywhere without provisioning).
+     *
+     * @param prefix Path prefix for segment files
+     * @param num_segments Ring depth (4 = one active, three draining)
+     * @param slots_per_segment Capacity per segment (65536 = 128MB)
+     * @return true if every segment was created and mapped
+     */
+    bool open(const char* prefix, size_t num_segments = 4,
+              size_t slots_per_segment = 65536) {
+        if (num_segments == 0 || num_segments > MAX_SEGMENTS ||
+            slots_per_segment == 0) [[unlikely]] {
+            return false;
+        }
+
+        prefix_ = prefix;
+        num_segments_ = num_segments;
+        slots_per_segment_ = slots_per_segment;
+        seg_bytes_ = sizeof(SegmentHeader) + slots_per_segment * SLOT_SIZE;
+
+        for (size_t s = 0; s < num_segments_; s++) {
+            Segment& seg = segments_[s];
+            char path[512];
+            std::snprintf(path, sizeof(path), "%s_%03zu.seg", prefix, s);
+
+            seg.fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (seg.fd < 0) [[unlikely]] {
+                close_all();
+                return false;
+            }
+            if (ftruncate(seg.fd, static_cast<off_t>(seg_bytes_)) != 0) [[unlikely]] {
+                close_all();
+                return false;
+            }
+
+            void* base = mmap(nullptr, seg_bytes_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, seg.fd, 0);
+            if (base == MAP_FAILED) [[unlikely]] {
+                close_all();
+                return false;
+            }
+            #ifdef MADV_HUGEPAGE
+            madvise(base, seg_bytes_, MADV_HUGEPAGE);
+            #endif
+
+            seg.base = static_cast<uint8_t*>(base);
+            seg.header = reinterpret_cast<SegmentHeader*>(seg.base);
+            seg.header->magic = SEG_MAGIC;
+            seg.header->slot_size = SLOT_SIZE;
+            seg.header->slot_count = static_cast<uint32_t>(slots_per_segment);
+            seg.header->used = 0;
+            seg.state.store(FREE, std::memory_order_relaxed);
+        }
+
+        segments_[0].state.store(ACTIVE, std::memory_order_relaxed);
+        active_ = 0;
+        cursor_ = 0;
+        return true;
+    }
+
+    /**
+     * Capture one frame (RX HOT PATH - polling core only)
+     *
+     * Cost breakdown for a 256B frame: one cursor check, 16B header +
+     * payload via streaming stores (~20-30ns, ZERO cache pollution),
+     * one sfence. Segment flip adds two atomic stores and only happens
+     * once per `slots_per_segment` packets.
+     *
+     * @param frame Packet bytes (the DMA buffer - no pre-copy needed)
+     * @param len Frame length (truncated to SNAP_LEN, recorded in full)
+     * @param timestamp_ns Hardware descriptor timestamp (or wall clock)
+     * @return false if every segment was full (counted in drops())
+     */
+    inline bool capture(const uint8_t* frame, size_t len,
+                        uint64_t timestamp_ns) {
+        if (cursor_ >= slots_per_segment_) [[unlikely]] {
+            if (!advance_segment()) [[unlikely]] {
+                drops_++;
+                return false;
+            }
+        }
+
+        Segment& seg = segments_[active_];
+        uint8_t* slot = seg.base + sizeof(SegmentHeader) + cursor_ * SLOT_SIZE;
+
+        const uint16_t cap_len =
+            static_cast<uint16_t>(len < SNAP_LEN ? len : SNAP_LEN);
+
+        // 16-byte record header, then payload - all through streaming
+        // stores so the captured bytes never touch L1/L2
+        SlotHeader hdr;
+        hdr.timestamp_ns = timestamp_ns;
+        hdr.cap_len = cap_len;
+        hdr.orig_len = static_cast<uint16_t>(len);
+        hdr.reserved = 0;
+        stream_copy(slot, &hdr, sizeof(hdr));
+        stream_copy(slot + sizeof(hdr), frame, cap_len);
+        #if defined(__x86_64__) || defined(__i386__)
+        _mm_sfence();  // Order the streaming stores before `used` below
+        #endif
+
+        cursor_++;
+        seg.header->used = static_cast<uint32_t>(cursor_);
+        packets_++;
+        bytes_ += cap_len;
+        return true;
+    }
+
+    /**
+     * Capture straight from the burst RX path - uses the descriptor's
+     * hardware timestamp when the NIC stamped the packet
+     */
+    inline bool capture(const RxView& pkt) {
+        uint64_t ts = pkt.hw_timestamp_ns ? pkt.hw_timestamp_ns
+                                          : ull_nic::tsc_clock().wall_now_ns();
+        return capture(pkt.data, pkt.len, ts);
+    }
+
+    /**
+     * Wrap a busy_wait_loop() callback so every packet is captured
+     * before processing - the tee shares the caller's packet pointer,
+     * no second copy, no second parse
+     */
+    template<typename Callback>
+    auto tee(Callback&& callback) {
+        return [this, cb = std::forward<Callback>(callback)]
+               (uint8_t* data, size_t len) mutable {
+            capture(data, len, ull_nic::tsc_clock().wall_now_ns());
+            cb(data, len);
+        };
+    }
+
+    /**
+     * Start the background rotator thread (off the polling cores!)
+     *
+     * Converts each FULL segment to `<prefix>_<n>.pcapng` and recycles
+     * it. Conversion is buffered stdio on a cold core - throughput
+     * there only bounds how long segments take to come back, never RX.
+     */
+    void start_rotator() {
+        if (rotator_running_.exchange(true)) {
+            return;
+        }
+        rotator_ = std::thread([this]() {
+            while (rotator_running_.load(std::memory_order_relaxed)) {
+                if (rotate_once() == 0) {
+                    // Nothing full - doze; rotation latency is bounded
+                    // by segment fill time (seconds), not this nap
+                    usleep(1000);
+                }
+            }
+        });
+    }
+
+    void stop_rotator() {
+        if (!rotator_running_.exchange(false)) {
+            return;
+        }
+        if (rotator_.joinable()) {
+            rotator_.join();
+        }
+    }
+
+    /**
+     * Drain one pass: convert every FULL segment to pcapng and free it
+     *
+     * Exposed for tests and for callers that own their own maintenance
+     * thread (same pattern as loopback_pump()).
+     *
+     * @return Segments converted this pass
+     */
+    size_t rotate_once() {
+        size_t rotated = 0;
+        for (size_t s = 0; s < num_segments_; s++) {
+            Segment& seg = segments_[s];
+            if (seg.state.load(std::memory_order_acquire) != FULL) {
+                continue;
+            }
+
+            char path[512];
+            std::snprintf(path, sizeof(path), "%s_%06llu.pcapng",
+                          prefix_.c_str(),
+                          static_cast<unsigned long long>(rotation_seq_++));
+            write_pcapng(seg, path);
+
+            // Recycle: reset the cursor metadata and hand it back
+            seg.header->used = 0;
+            seg.state.store(FREE, std::memory_order_release);
+            segments_rotated_++;
+            rotated++;
+        }
+        return rotated;
+    }
+
+    /**
+     * Flush the ACTIVE segment too (shutdown path): marks it full so
+     * the next rotate_once() converts the partial segment
+     */
+    void flush_active() {
+        Segment& seg = segments_[active_];
+        if (seg.header->used > 0) {
+            seg.state.store(FULL, std::memory_order_release);
+            // Writer moves on; if no FREE segment exists the next
+            // capture() drops - acceptable on the shutdown path
+            advance_segment();
+        }
+    }
+
+    // Monitoring (single-writer counters, same read contract as
+    // PollGovernorStats: torn reads are at worst one sample stale)
+    uint64_t packets() const { return packets_; }
+    uint64_t bytes() const { return bytes_; }
+    uint64_t drops() const { return drops_; }
+    uint64_t segments_rotated() const { return segments_rotated_; }
+
+private:
+    static constexpr size_t MAX_SEGMENTS = 16;
+
+    enum SegState : uint32_t { FREE = 0, ACTIVE = 1, FULL = 2 };
+
+    /**
+     * On-disk segment header (page-sized so slot 0 is hugepage-aligned)
+     */
+    struct SegmentHeader {
+        uint64_t magic;
+        uint32_t slot_size;
+        uint32_t slot_count;
+        uint32_t used;          // Committed slots (plain store, single writer)
+        uint8_t pad[4096 - 20];
+    };
+    static_assert(sizeof(SegmentHeader) == 4096, "header must be one page");
+
+    /**
+     * On-disk record header: 16 bytes ahead of each frame
+     */
+    struct SlotHeader {
+        uint64_t timestamp_ns;  // Hardware descriptor stamp (wall clock)
+        uint16_t cap_len;       // Bytes stored in the slot
+        uint16_t orig_len;      // Bytes on the wire
+        uint32_t reserved;
+    };
+    static_assert(sizeof(SlotHeader) == 16, "slot header layout is on-disk ABI");
+
+    struct Segment {
+        int fd = -1;
+        uint8_t* base = nullptr;
+        SegmentHeader* header = nullptr;
+        std::atomic<uint32_t> state{FREE};
+    };
+
+    std::string prefix_;
+    size_t num_segments_ = 0;
+    size_t slots_per_segment_ = 0;
+    size_t seg_bytes_ = 0;
+    Segment segments_[MAX_SEGMENTS];
+
+    // Hot-path state (polling core only)
+    size_t active_ = 0;
+    size_t cursor_ = 0;
+    uint64_t packets_ = 0;
+    uint64_t bytes_ = 0;
+    uint64_t drops_ = 0;
+
+    // Rotator state
+    std::thread rotator_;
+    std::atomic<bool> rotator_running_{false};
+    uint64_t rotation_seq_ = 0;
+    uint64_t segments_rotated_ = 0;
+
+    /**
+     * Streaming copy: cache-bypassing stores for capture traffic
+     *
+     * movntdq writes go straight to write-combining buffers and DRAM -
+     * the polling core's L1/L2 stay full of descriptors and flow
+     * tables instead of bytes nobody here will ever read. Destination
+     * slots are 16-aligned by construction (SLOT_SIZE is a multiple of
+     * 16 and slot 0 starts on a page); the sub-16-byte tail goes
+     * through one regular store pair.
+     */
+    static inline void stream_copy(void* dst, const void* src, size_t len) {
+        #if defined(__x86_64__) || defined(__i386__)
+        uint8_t* d = static_cast<uint8_t*>(dst);
+        const uint8_t* s = static_cast<const uint8_t*>(src);
+        size_t n16 = len & ~size_t(15);
+        for (size_t i = 0; i < n16; i += 16) {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(s + i));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), v);
+        }
+        if (len & 15) {
+            std::memcpy(d + n16, s + n16, len & 15);
+        }
+        #else
+        std::memcpy(dst, src, len);
+        #endif
+    }
+
+    /**
+     * Flip to the next FREE segment (hot path, once per segment fill)
+     */
+    bool advance_segment() {
+        segments_[active_].state.store(FULL, std::memory_order_release);
+        for (size_t i = 1; i <= num_segments_; i++) {
+            size_t cand = (active_ + i) % num_segments_;
+            uint32_t expect = FREE;
+            if (segments_[cand].state.compare_exchange_strong(
+                    expect, ACTIVE, std::memory_order_acq_rel)) {
+                active_ = cand;
+                cursor_ = 0;
+                return true;
+            }
+        }
+        return false;  // Rotator behind on every segment
+    }
+
+    /**
+     * Convert one full segment to pcapng (rotator thread, cold path)
+     *
+     * Emits the same block sequence pcap_replay.hpp parses: SHB, one
+     * Ethernet IDB carrying if_tsresol=9 (nanosecond stamps), then one
+     * EPB per slot. Buffered stdio is fine here - this thread has no
+     * latency budget.
+     */
+    void write_pcapng(const Segment& seg, const char* path) const {
+        FILE* f = std::fopen(path, "wb");
+        if (!f) {
+            return;
+        }
+
+        auto w32 = [&](uint32_t v) { std::fwrite(&v, 4, 1, f); };
+        auto w16 = [&](uint16_t v) { std::fwrite(&v, 2, 1, f); };
+
+        // Section Header Block
+        w32(0x0A0D0D0A); w32(28); w32(0x1A2B3C4D);
+        w16(1); w16(0);                       // Version 1.0
+        w32(0xFFFFFFFF); w32(0xFFFFFFFF);     // Section length: unknown
+        w32(28);
+
+        // Interface Description Block: Ethernet, ns resolution
+        w32(0x00000001); w32(32);
+        w16(1); w16(0);                       // LINKTYPE_ETHERNET
+        w32(SNAP_LEN);
+        w16(9); w16(1);                       // if_tsresol = 9 (10^-9)
+        { uint8_t v[4] = {9, 0, 0, 0}; std::fwrite(v, 4, 1, f); }
+        w16(0); w16(0);                       // opt_endofopt
+        w32(32);
+
+        // Enhanced Packet Blocks
+        const uint32_t used = seg.header->used;
+        for (uint32_t i = 0; i < used; i++) {
+            const uint8_t* slot =
+                seg.base + sizeof(SegmentHeader) + size_t(i) * SLOT_SIZE;
+            SlotHeader hdr;
+            std::memcpy(&hdr, slot, sizeof(hdr));
+
+            const uint32_t pad = (4 - (hdr.cap_len & 3)) & 3;
+            const uint32_t block_len = 32 + hdr.cap_len + pad;
+            w32(0x00000006); w32(block_len);
+            w32(0);                           // Interface 0
+            w32(static_cast<uint32_t>(hdr.timestamp_ns >> 32));
+            w32(static_cast<uint32_t>(hdr.timestamp_ns));
+            w32(hdr.cap_len); w32(hdr.orig_len);
+            std::fwrite(slot + sizeof(SlotHeader), 1, hdr.cap_len, f);
+            { uint8_t z[4] = {}; std::fwrite(z, 1, pad, f); }
+            w32(block_len);
+        }
+
+        std::fclose(f);
+    }
+
+    void close_all() {
+        stop_rotator();
+        for (size_t s = 0; s < MAX_SEGMENTS; s++) {
+            Segment& seg = segments_[s];
+            if (seg.base) {
+                munmap(seg.base, seg_bytes_);
+                seg.base = nullptr;
+                seg.header = nullptr;
+            }
+            if (seg.fd >= 0) {
+                ::close(seg.fd);
+                seg.fd = -1;
+            }
+        }
+    }
+};
+
+} // namespace hardware
+} // namespace hft
@@ -4,6 +4,11 @@
 #include <ctime>
 #include <chrono>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#include <cpuid.h>      // __get_cpuid (TSC frequency via leaf 0x15)
+#endif
+
 /**
  * @file common_types.hpp
  * @brief Common types and utilities for Ultra-Low-Latency NIC drivers
@@ -46,12 +51,22 @@ inline uint64_t get_timestamp() {
  * @param ticks TSC ticks from RDTSC instruction
  * @param tsc_freq TSC frequency in Hz (typically 2-4 GHz)
  * @return Nanoseconds
- * 
- * To calibrate TSC frequency on Linux:
- * cat /sys/devices/system/cpu/cpu0/cpufreq/base_frequency
+ *
+ * The multiply goes through 128-bit arithmetic: the old 64-bit
+ * `ticks * 1e9` overflowed for any ticks value above ~18.4 seconds of
+ * uptime, silently corrupting every long-running measurement.
+ *
+ * Prefer TscClock below - it measures the actual frequency instead of
+ * trusting the caller's (usually defaulted, usually wrong) tsc_freq.
  */
 inline uint64_t tsc_to_ns(uint64_t ticks, uint64_t tsc_freq = 2'800'000'000) {
-    return (ticks * 1'000'000'000) / tsc_freq;
+#ifdef __SIZEOF_INT128__
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(ticks) * 1'000'000'000u) / tsc_freq);
+#else
+    return (ticks / tsc_freq) * 1'000'000'000 +
+           ((ticks % tsc_freq) * 1'000'000'000) / tsc_freq;
+#endif
 }
 
 /**
@@ -65,6 +80,240 @@ inline uint64_t get_wall_time_ns() {
     ).count();
 }
 
+// ============================================================================
+// Calibrated TSC Clock
+// ============================================================================
+
+/**
+ * @class TscClock
+ * @brief Runtime-calibrated TSC-to-nanosecond conversion, overflow-free
+ *
+ * Two defects in ad-hoc tsc_to_ns() usage, both fixed here:
+ *
+ * 1. The hard-coded 2.8GHz default: every box with a different base
+ *    clock reads wrong absolute latencies. TscClock asks the CPU
+ *    (CPUID leaf 0x15 gives the exact crystal-derived ratio on Skylake
+ *    and later) and falls back to a measured calibration against
+ *    CLOCK_MONOTONIC_RAW - the one clock NTP never slews.
+ *
+ * 2. Overflow: `ticks * 1e9 / freq` in 64 bits wraps after ~18.4s of
+ *    ticks. Conversion here is a precomputed fixed-point multiplier -
+ *    ns = (ticks * mult) >> 32 via a 128-bit product. One mul, one
+ *    shift, no division, exact to ~0.2 parts per billion, valid for
+ *    the full 64-bit tick range.
+ *
+ * The calibration also anchors the TSC to wall-clock time, so
+ * to_wall_ns() maps any raw TSC reading onto the same epoch-ns
+ * timeline as hardware (PHC-derived) timestamps - software and
+ * hardware stamps become directly comparable.
+ *
+ * Usage: `tsc_clock()` returns the process-wide instance; the first
+ * call pays the one-time calibration (~20ms if CPUID can't answer),
+ * so make it during startup, not in the hot loop.
+ */
+class TscClock {
+public:
+    /** @brief Calibrate now (see class docs; prefer tsc_clock()) */
+    TscClock() {
+        uint64_t hz = tsc_hz_from_cpuid();
+        if (hz == 0) {
+            hz = tsc_hz_measured();
+        }
+        tsc_hz_ = hz;
+
+        // Fixed-point multiplier: ns = ticks * (1e9 << 32 / hz) >> 32.
+        // For any hz >= 0.25GHz the multiplier fits well inside 64 bits
+        // and the 128-bit product cannot overflow.
+        mult_ = (static_cast<unsigned __int128>(1'000'000'000u) << SHIFT) / hz;
+
+        // Anchor for the wall-clock mapping
+        anchor_tsc_ = get_timestamp();
+        anchor_wall_ns_ = get_wall_time_ns();
+    }
+
+    /** @brief Measured (or CPUID-reported) TSC frequency in Hz */
+    uint64_t hz() const { return tsc_hz_; }
+
+    /**
+     * @brief Ticks to nanoseconds: one 128-bit mul + shift
+     *
+     * Valid for the full uint64 tick range - no 18-second cliff.
+     */
+    inline uint64_t to_ns(uint64_t ticks) const {
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(ticks) * mult_) >> SHIFT);
+    }
+
+    /** @brief Nanoseconds to ticks (for computing TSC deadlines) */
+    inline uint64_t from_ns(uint64_t ns) const {
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(ns) * tsc_hz_) / 1'000'000'000u);
+    }
+
+    /**
+     * @brief Map a raw TSC reading onto wall-clock epoch nanoseconds
+     *
+     * Directly comparable to get_wall_time_ns() and to NIC hardware
+     * timestamps that PhcTscSync has converted - one timeline for
+     * software and hardware stamps.
+     */
+    inline uint64_t to_wall_ns(uint64_t tsc) const {
+        return anchor_wall_ns_ + to_ns(tsc - anchor_tsc_);
+    }
+
+    /** @brief Wall-clock "now" derived from the TSC - no syscall */
+    inline uint64_t wall_now_ns() const {
+        return to_wall_ns(get_timestamp());
+    }
+
+private:
+    static constexpr unsigned SHIFT = 32;
+
+    /**
+     * CPUID leaf 0x15: TSC/crystal ratio + crystal Hz. Exact when the
+     * CPU reports it (Skylake+); zero means "measure it yourself".
+     */
+    static uint64_t tsc_hz_from_cpuid() {
+    #if defined(__x86_64__) || defined(__i386__)
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(0x15, &eax, &ebx, &ecx, &edx) &&
+            eax != 0 && ebx != 0 && ecx != 0) {
+            // tsc_hz = crystal_hz * (numerator / denominator)
+            return static_cast<uint64_t>(ecx) * ebx / eax;
+        }
+    #endif
+        return 0;
+    }
+
+    /**
+     * Measured fallback: TSC ticks across a 20ms CLOCK_MONOTONIC_RAW
+     * window. RAW because NTP slews MONOTONIC and would bias the rate.
+     */
+    static uint64_t tsc_hz_measured() {
+        struct timespec t0, t1;
+    #ifdef CLOCK_MONOTONIC_RAW
+        const clockid_t clk = CLOCK_MONOTONIC_RAW;
+    #else
+        const clockid_t clk = CLOCK_MONOTONIC;
+    #endif
+        clock_gettime(clk, &t0);
+        const uint64_t c0 = get_timestamp();
+        int64_t elapsed;
+        do {
+            clock_gettime(clk, &t1);
+            elapsed = (t1.tv_sec - t0.tv_sec) * 1'000'000'000LL +
+                      (t1.tv_nsec - t0.tv_nsec);
+        } while (elapsed < 20'000'000LL);
+        const uint64_t c1 = get_timestamp();
+
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(c1 - c0) * 1'000'000'000u) /
+            static_cast<uint64_t>(elapsed));
+    }
+
+    uint64_t tsc_hz_;          ///< TSC frequency in Hz
+    uint64_t mult_;            ///< Fixed-point ns-per-tick, Q32
+    uint64_t anchor_tsc_;      ///< TSC at calibration
+    uint64_t anchor_wall_ns_;  ///< Wall-clock ns at calibration
+};
+
+/**
+ * @brief Process-wide calibrated clock (calibrates on first call)
+ *
+ * Touch it once during startup so the hot path never pays the
+ * calibration: `ull_nic::tsc_clock();`
+ */
+inline const TscClock& tsc_clock() {
+    static const TscClock clock;
+    return clock;
+}
+
+// ============================================================================
+// PHC-to-TSC Clock Synchronization
+// ============================================================================
+
+/**
+ * @class PhcTscSync
+ * @brief Maps NIC hardware (PHC) timestamps onto the CPU's TSC timeline
+ *
+ * Hardware RX timestamps are stamped by the NIC's PTP Hardware Clock;
+ * everything else we measure is in TSC ticks. Comparing the two naively
+ * mixes clock domains - the PHC and TSC free-run against each other at
+ * tens of ppm, which is microseconds of drift per minute.
+ *
+ * Usage:
+ * 1. Call calibrate(phc_now_ns, tsc_now) twice, >= 10ms apart, reading
+ *    both clocks back to back (e.g. PHC registers bracketed by rdtsc).
+ *    Repeat periodically (once a second is plenty) to track drift.
+ * 2. phc_to_tsc_ns() then converts a descriptor timestamp onto the
+ *    tsc_to_ns() timeline with NO syscall: subtract, multiply, add.
+ *
+ * Accuracy is limited by the calibration read pairing (~100ns on PCIe)
+ * - far better than the 300-600ns software-stamp jitter it replaces.
+ */
+class PhcTscSync {
+public:
+    PhcTscSync()
+        : phc_ref_(0)
+        , tsc_ref_(0)
+        , tsc_ticks_per_phc_ns_(0.0)
+        , have_first_(false) {}
+
+    /**
+     * @brief Feed one simultaneous (PHC, TSC) clock reading
+     *
+     * The first call sets the reference point; each later call updates
+     * the drift ratio from the span since the previous reference.
+     */
+    void calibrate(uint64_t phc_ns, uint64_t tsc_ticks) {
+        if (have_first_) {
+            const uint64_t dphc = phc_ns - phc_ref_;
+            if (dphc > 0) {
+                tsc_ticks_per_phc_ns_ =
+                    static_cast<double>(tsc_ticks - tsc_ref_) /
+                    static_cast<double>(dphc);
+            }
+        }
+        phc_ref_ = phc_ns;
+        tsc_ref_ = tsc_ticks;
+        have_first_ = true;
+    }
+
+    /**
+     * @brief Is the converter usable (two calibration points seen)?
+     */
+    bool synced() const { return tsc_ticks_per_phc_ns_ > 0.0; }
+
+    /**
+     * @brief Convert a PHC timestamp to the equivalent TSC tick count
+     *
+     * No syscall, no branch: subtract, multiply, add (~5ns).
+     */
+    inline uint64_t phc_to_tsc(uint64_t phc_ns) const {
+        const double dns = static_cast<double>(phc_ns) -
+                           static_cast<double>(phc_ref_);
+        return tsc_ref_ +
+               static_cast<int64_t>(dns * tsc_ticks_per_phc_ns_);
+    }
+
+    /**
+     * @brief Convert a PHC timestamp to nanoseconds on the TSC timeline
+     *
+     * Result is directly comparable to tsc_clock().to_ns(get_timestamp()).
+     * Uses the process-wide calibrated clock - no assumed frequency
+     * (see TscClock for why a hard-coded base clock is poison).
+     */
+    inline uint64_t phc_to_tsc_ns(uint64_t phc_ns) const {
+        return tsc_clock().to_ns(phc_to_tsc(phc_ns));
+    }
+
+private:
+    uint64_t phc_ref_;             ///< PHC ns at last calibration
+    uint64_t tsc_ref_;             ///< TSC ticks at last calibration
+    double tsc_ticks_per_phc_ns_;  ///< Measured drift ratio
+    bool have_first_;              ///< First reference point recorded
+};
+
 // ============================================================================
 // Packet Statistics Structure
 // ============================================================================
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "numa_placement.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * DMA Arena: One Hugepage Reservation, Zero-Syscall Address Translation
+ *
+ * The problem with per-buffer allocation:
+ * ──────────────────────────────────────
+ *
+ * allocate_dma_memory<T>() does a separate mmap + mlock PER ALLOCATION -
+ * one per ring buffer means thousands of VMAs, thousands of TLB entries,
+ * and a kernel VMA tree the scheduler has to walk. Worse, virt_to_phys()
+ * opens /proc/self/pagemap, lseeks and reads for EVERY translation: an
+ * open/read/close syscall triple (~1-2 us) that is tolerable at ring
+ * setup but fatal if a descriptor is ever re-armed with a fresh buffer
+ * on the hot path.
+ *
+ * The arena model:
+ * ───────────────
+ *
+ * 1. Reserve ONE large region of 2MB hugepages up front (mmap+mlock once)
+ * 2. Resolve the physical address of every page ONCE at creation, into a
+ *    flat lookup table
+ * 3. Carve buffers out of the region with a bump allocator (a pointer
+ *    increment - no syscalls, no metadata, no fragmentation)
+ * 4. virt_to_phys() becomes: table[(addr - base) >> page_shift] + offset
+ *    - a subtract, a shift, an indexed load and an add. ~2-3 ns.
+ *
+ * Side benefits: one VMA instead of thousands, hugepage TLB coverage
+ * (one entry per 2MB instead of 512), and physically-contiguous buffers
+ * within each hugepage.
+ */
+
+namespace hft {
+namespace hardware {
+
+class DmaArena {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;  // 2MB
+    static constexpr size_t SMALL_PAGE_SIZE = 4096;            // Fallback
+
+    DmaArena()
+        : base_(nullptr)
+        , size_(0)
+        , offset_(0)
+        , page_size_(0)
+    {}
+
+    ~DmaArena() {
+        destroy();
+    }
+
+    DmaArena(const DmaArena&) = delete;
+    DmaArena& operator=(const DmaArena&) = delete;
+
+    /**
+     * Reserve and pin the arena, resolving physical addresses up front
+     *
+     * One-time cost: mmap + mlock + one pagemap pass (~10 us per MB).
+     * After this call no arena operation touches the kernel.
+     *
+     * @param size Bytes to reserve (rounded up to a hugepage multiple)
+     * @param numa_node Bind the reservation to this NUMA node (-1 = no
+     *        binding, first-touch decides). The mbind happens BEFORE
+     *        the fault-in loop so every page allocates on the target
+     *        node regardless of which thread calls create().
+     * @return true if the arena is ready (hugepages or 4K fallback)
+     */
+    bool create(size_t size, int numa_node = -1) {
+        if (base_) [[unlikely]] {
+            return false;  // Already created
+        }
+
+        // Round up to a whole number of hugepages
+        size_ = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+        #ifdef __linux__
+        #ifndef MAP_HUGETLB
+        #define MAP_HUGETLB 0x40000
+        #endif
+        void* ptr = mmap(nullptr, size_,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                        -1, 0);
+        if (ptr != MAP_FAILED) {
+            page_size_ = HUGE_PAGE_SIZE;
+        } else {
+            // No hugepages reserved on this box - fall back to 4K pages
+            // (translation table is just bigger; hot path is identical)
+            ptr = mmap(nullptr, size_,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+            page_size_ = SMALL_PAGE_SIZE;
+        }
+        #else
+        void* ptr = mmap(nullptr, size_,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1, 0);
+        page_size_ = SMALL_PAGE_SIZE;
+        #endif
+
+        if (ptr == MAP_FAILED) [[unlikely]] {
+            size_ = 0;
+            return false;
+        }
+
+        base_ = static_cast<uint8_t*>(ptr);
+
+        // NUMA policy goes on the VMA before any page exists, so the
+        // fault-in loop below allocates every page on the right node
+        if (numa_node >= 0) {
+            bind_to_node(base_, size_, numa_node);
+        }
+
+        // Pin: DMA targets must never be swapped or migrated
+        mlock(base_, size_);
+
+        // Touch every page so it is faulted in BEFORE we read pagemap
+        // (an untouched page has no physical frame yet)
+        for (size_t off = 0; off < size_; off += page_size_) {
+            base_[off] = 0;
+        }
+
+        // Resolve every page's physical address in ONE pagemap pass
+        return resolve_physical_addresses();
+    }
+
+    /**
+     * Carve a buffer out of the arena (bump allocator)
+     *
+     * Performance: pointer arithmetic only - no syscalls, safe anywhere.
+     *
+     * @param count Number of elements
+     * @param align Alignment in bytes (power of 2, default cache line)
+     * @return Pointer into the arena, or nullptr if exhausted
+     */
+    template<typename T>
+    T* alloc(size_t count, size_t align = 64) {
+        size_t bytes = count * sizeof(T);
+        size_t aligned_off = (offset_ + align - 1) & ~(align - 1);
+
+        if (aligned_off + bytes > size_) [[unlikely]] {
+            return nullptr;  // Arena exhausted - size it correctly up front
+        }
+
+        offset_ = aligned_off + bytes;
+        return reinterpret_cast<T*>(base_ + aligned_off);
+    }
+
+    /**
+     * Translate an arena address to its physical address (HOT-PATH SAFE)
+     *
+     * Performance: ~2-3 ns (subtract, shift, indexed load, add).
+     * No syscalls - the table was filled once at create().
+     *
+     * @param virt_addr Address inside the arena
+     * @return Physical address, or 0 if outside the arena
+     */
+    inline uint64_t virt_to_phys(const void* virt_addr) const {
+        uint64_t off = static_cast<const uint8_t*>(virt_addr) - base_;
+        if (off >= size_) [[unlikely]] {
+            return 0;  // Not an arena address
+        }
+        size_t page = off / page_size_;
+        return page_phys_[page] + (off & (page_size_ - 1));
+    }
+
+    /**
+     * Does this address belong to the arena?
+     */
+    inline bool contains(const void* virt_addr) const {
+        uint64_t off = static_cast<const uint8_t*>(virt_addr) - base_;
+        return off < size_;
+    }
+
+    /**
+     * Bytes still available for alloc()
+     */
+    size_t remaining() const { return size_ - offset_; }
+
+    size_t size() const { return size_; }
+    bool valid() const { return base_ != nullptr; }
+    uint8_t* base() const { return base_; }
+    size_t page_size() const { return page_size_; }
+
+    /**
+     * Release the reservation (invalidates all buffers carved from it)
+     */
+    void destroy() {
+        if (base_) {
+            munmap(base_, size_);
+            base_ = nullptr;
+            size_ = 0;
+            offset_ = 0;
+            page_phys_.clear();
+        }
+    }
+
+private:
+    uint8_t* base_;                   // Arena base address
+    size_t size_;                     // Total reservation size
+    size_t offset_;                   // Bump-allocator cursor
+    size_t page_size_;                // 2MB (hugepages) or 4KB (fallback)
+    std::vector<uint64_t> page_phys_; // Physical address of each page
+
+    /**
+     * Fill page_phys_ from /proc/self/pagemap in one pass
+     *
+     * This is the ONLY pagemap access the arena ever performs.
+     */
+    bool resolve_physical_addresses() {
+        size_t num_pages = size_ / page_size_;
+        page_phys_.resize(num_pages, 0);
+
+        #ifdef __linux__
+        int fd = open("/proc/self/pagemap", O_RDONLY);
+        if (fd < 0) [[unlikely]] {
+            return false;
+        }
+
+        for (size_t i = 0; i < num_pages; i++) {
+            uint64_t virt = reinterpret_cast<uint64_t>(base_) + i * page_size_;
+            uint64_t entry_off = (virt / SMALL_PAGE_SIZE) * 8;
+
+            uint64_t pfn_entry = 0;
+            if (pread(fd, &pfn_entry, 8, entry_off) != 8) [[unlikely]] {
+                close(fd);
+                return false;
+            }
+
+            uint64_t pfn = pfn_entry & ((1ULL << 55) - 1);
+            page_phys_[i] = pfn * SMALL_PAGE_SIZE;
+        }
+
+        close(fd);
+        return true;
+        #else
+        // Non-Linux: identity mapping placeholder (no DMA anyway)
+        for (size_t i = 0; i < num_pages; i++) {
+            page_phys_[i] = reinterpret_cast<uint64_t>(base_) + i * page_size_;
+        }
+        return true;
+        #endif
+    }
+};
+
+} // namespace hardware
+} // namespace hft
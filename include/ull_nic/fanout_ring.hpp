@@ -0,0 +1,381 @@
+#pragma once
+
+#include "custom_nic_driver.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Shared-Memory Fan-Out Ring: One Polling Core, N Consumer Processes
+ *
+ * The problem:
+ * ───────────
+ *
+ * One busy_wait_loop() core owns the NIC queue, but five downstream
+ * processes (strategy, risk, capture, surveillance, billing) all want
+ * the packet stream. A second ring per consumer is impossible (single
+ * hardware queue) and a TCP sidecar adds ~20us. The stream has to be
+ * BROADCAST, not handed off: every consumer sees every packet.
+ *
+ * The design (single-writer broadcast ring, wait-free readers):
+ * ────────────────────────────────────────────────────────────
+ *
+ * A shared-memory region holds a power-of-2 array of fixed-size slots.
+ * Each slot carries the sequence number of the message it holds:
+ *
+ *   Writer, message m -> slot m & (N-1):
+ *     1. stamp slot.seq = m | BUSY     (claim - invalidates old message)
+ *     2. copy payload + metadata
+ *     3. stamp slot.seq = m  (release) (publish)
+ *
+ *   Reader at cursor c -> slot c & (N-1):
+ *     - slot.seq <  c : nothing new yet            -> EMPTY
+ *     - slot.seq == c : copy, re-check seq == c    -> OK (else lapped)
+ *     - anything else : writer lapped us           -> GAP, resync
+ *
+ * Properties that matter:
+ * - The writer NEVER waits for readers - a slow consumer can only hurt
+ *   itself. The polling core's publish cost is a bounded memcpy plus
+ *   two sequence stores (~40-60ns for a 64B packet).
+ * - Readers are wait-free and independent: each keeps a private cursor,
+ *   no shared read position, no reference counts.
+ * - Lag is DETECTED, not prevented: when the writer laps a reader, the
+ *   seq re-check catches the torn read and the reader resyncs to the
+ *   live edge, reporting exactly how many messages it lost.
+ *
+ * Usage (writer, on the polling core):
+ * ```cpp
+ * FanoutRing ring;
+ * ring.create("/ull_nic_md", 4096);
+ * nic.busy_wait_loop_burst([&](const RxView* pkts, size_t n) {
+ *     for (size_t i = 0; i < n; i++) ring.publish(pkts[i]);
+ * });
+ * ```
+ *
+ * Usage (each consumer process):
+ * ```cpp
+ * FanoutReader reader;
+ * reader.open("/ull_nic_md");
+ * uint8_t buf[FanoutRing::SLOT_PAYLOAD];
+ * FanoutReader::Message msg{buf};
+ * for (;;) {
+ *     switch (reader.read(msg)) {
+ *         case FanoutReader::OK:    handle(buf, msg.len); break;
+ *         case FanoutReader::GAP:   log_drops(msg.dropped); break;
+ *         case FanoutReader::EMPTY: break;
+ *     }
+ * }
+ * ```
+ */
+
+namespace hft {
+namespace hardware {
+
+class FanoutRing {
+public:
+    static constexpr size_t SLOT_PAYLOAD = 2048;   // = PACKET_BUFFER_SIZE
+    static constexpr uint64_t MAGIC = 0x554C4C4652494E47ULL;  // "ULLFRING"
+    static constexpr uint64_t BUSY = 1ULL << 63;   // Claim bit in slot seq
+
+    /**
+     * One broadcast slot. The sequence stamp doubles as the seqlock:
+     * BUSY set means the writer is mid-copy.
+     */
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq;   // Message number (| BUSY while writing)
+        uint16_t len;                // Payload length
+        uint64_t hw_timestamp_ns;    // NIC PHC stamp carried through
+        uint8_t payload[SLOT_PAYLOAD];
+    };
+
+    /**
+     * Region header - one cache line of identity, one for the write edge
+     */
+    struct Header {
+        uint64_t magic;              // Layout check across processes
+        uint64_t slot_count;         // Power of 2
+        uint64_t slot_payload;       // SLOT_PAYLOAD at creation time
+        uint8_t pad[64 - 3 * sizeof(uint64_t)];
+        alignas(64) std::atomic<uint64_t> next_seq;  // First unwritten seq
+    };
+
+    FanoutRing() : header_(nullptr), slots_(nullptr), mask_(0), seq_(0) {}
+
+    ~FanoutRing() { destroy(); }
+
+    FanoutRing(const FanoutRing&) = delete;
+    FanoutRing& operator=(const FanoutRing&) = delete;
+
+    /**
+     * Create (or recreate) the shared region - WRITER side, call once
+     *
+     * @param shm_name POSIX shm name, e.g. "/ull_nic_md"
+     * @param slot_count Ring size, power of 2 (4096 slots = ~8.5MB and
+     *        ~270us of lag headroom at 15 Mpps before a reader is lapped)
+     */
+    bool create(const char* shm_name, size_t slot_count) {
+        if ((slot_count & (slot_count - 1)) != 0) [[unlikely]] {
+            return false;  // Power of 2 required (index wrap is a mask)
+        }
+
+        shm_unlink(shm_name);  // Stale region from a dead writer
+        int fd = shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) [[unlikely]] {
+            return false;
+        }
+
+        size_t size = sizeof(Header) + slot_count * sizeof(Slot);
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) [[unlikely]] {
+            close(fd);
+            return false;
+        }
+
+        void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) [[unlikely]] {
+            return false;
+        }
+        mlock(mem, size);  // The polling core must never page-fault
+
+        header_ = static_cast<Header*>(mem);
+        slots_ = reinterpret_cast<Slot*>(header_ + 1);
+        mask_ = slot_count - 1;
+        seq_ = 0;
+
+        // Stamp every slot "one lap behind" so readers at cursor 0 see
+        // EMPTY, not garbage (seq < cursor means not yet written)
+        for (size_t i = 0; i <= mask_; i++) {
+            slots_[i].seq.store(BUSY, std::memory_order_relaxed);
+        }
+
+        header_->slot_count = slot_count;
+        header_->slot_payload = SLOT_PAYLOAD;
+        header_->next_seq.store(0, std::memory_order_relaxed);
+        // Magic LAST - readers spin on it to know the region is ready
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = MAGIC;
+        return true;
+    }
+
+    /**
+     * Broadcast one packet (HOT PATH - writer core only)
+     *
+     * Wait-free: two sequence stores around a bounded memcpy. Oversized
+     * packets are truncated to SLOT_PAYLOAD (jumbo frames don't belong
+     * on this path; consumers see the original length and can tell).
+     */
+    inline void publish(const uint8_t* data, uint16_t len,
+                        uint64_t hw_timestamp_ns = 0) {
+        Slot& slot = slots_[seq_ & mask_];
+
+        // Claim: readers of the OLD message in this slot now see a
+        // sequence from the future and resync instead of reading torn data
+        slot.seq.store(seq_ | BUSY, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint16_t copy_len = (len < SLOT_PAYLOAD)
+                          ? len : static_cast<uint16_t>(SLOT_PAYLOAD);
+        std::memcpy(slot.payload, data, copy_len);
+        slot.len = len;
+        slot.hw_timestamp_ns = hw_timestamp_ns;
+
+        // Publish: payload visible before the stamp (release)
+        slot.seq.store(seq_, std::memory_order_release);
+
+        seq_++;
+        header_->next_seq.store(seq_, std::memory_order_release);
+    }
+
+    /** Broadcast a received view (carries the hardware timestamp) */
+    inline void publish(const RxView& view) {
+        publish(view.data, view.len, view.hw_timestamp_ns);
+    }
+
+    uint64_t sequence() const { return seq_; }
+
+    void destroy() {
+        if (header_) {
+            munmap(header_, sizeof(Header) + (mask_ + 1) * sizeof(Slot));
+            header_ = nullptr;
+            slots_ = nullptr;
+        }
+    }
+
+private:
+    Header* header_;
+    Slot* slots_;
+    uint64_t mask_;
+    uint64_t seq_;   // Writer-private - the atomic in the header is for readers
+};
+
+/**
+ * FanoutReader: read-only consumer view of a FanoutRing
+ *
+ * One instance per consumer process. Wait-free; never blocks or slows
+ * the writer. A lagging reader loses data (by design) but always KNOWS
+ * it did - `dropped` reports the exact gap.
+ */
+class FanoutReader {
+public:
+    enum Result {
+        EMPTY,   // No new message at the cursor
+        OK,      // Message copied out
+        GAP      // Writer lapped us - cursor resynced, msg.dropped set
+    };
+
+    /**
+     * One delivered message. `data` must point at a caller buffer of at
+     * least FanoutRing::SLOT_PAYLOAD bytes; the ring copies into it so
+     * the consumer owns the bytes outright (no lifetime coupling to the
+     * writer's laps).
+     */
+    struct Message {
+        uint8_t* data;             // Caller-provided buffer (in)
+        uint16_t len;              // Original packet length (out)
+        uint64_t hw_timestamp_ns;  // NIC PHC stamp (out)
+        uint64_t sequence;         // Message number (out)
+        uint64_t dropped;          // Messages lost at last GAP (out)
+    };
+
+    FanoutReader() : header_(nullptr), slots_(nullptr), mask_(0), cursor_(0) {}
+
+    ~FanoutReader() { close_ring(); }
+
+    /**
+     * Map an existing ring read-only and start at the LIVE EDGE
+     *
+     * Starting at the live edge (not sequence 0) means a late-started
+     * consumer doesn't replay a lap of stale history.
+     */
+    bool open(const char* shm_name) {
+        int fd = shm_open(shm_name, O_RDONLY, 0);
+        if (fd < 0) [[unlikely]] {
+            return false;
+        }
+
+        // Header first, to learn the slot count
+        Header* hdr = static_cast<Header*>(
+            mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0));
+        if (hdr == MAP_FAILED || hdr->magic != FanoutRing::MAGIC ||
+            hdr->slot_payload != FanoutRing::SLOT_PAYLOAD) [[unlikely]] {
+            if (hdr != MAP_FAILED) {
+                munmap(hdr, sizeof(Header));
+            }
+            close(fd);
+            return false;
+        }
+
+        size_t slot_count = hdr->slot_count;
+        munmap(hdr, sizeof(Header));
+
+        size_t size = sizeof(Header) + slot_count * sizeof(Slot);
+        void* mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) [[unlikely]] {
+            return false;
+        }
+
+        header_ = static_cast<Header*>(mem);
+        slots_ = reinterpret_cast<const Slot*>(header_ + 1);
+        mask_ = slot_count - 1;
+        cursor_ = header_->next_seq.load(std::memory_order_acquire);
+        return true;
+    }
+
+    /**
+     * Try to read the next message (HOT PATH - consumer side)
+     *
+     * Performance: ~30-50ns per message (seq load, memcpy, seq
+     * re-check); EMPTY polls are two cached loads.
+     */
+    inline Result read(Message& msg) {
+        const Slot& slot = slots_[cursor_ & mask_];
+
+        const uint64_t s1 = slot.seq.load(std::memory_order_acquire);
+        if (s1 != cursor_) [[unlikely]] {
+            if ((s1 & ~FanoutRing::BUSY) < cursor_ ||
+                s1 == (cursor_ | FanoutRing::BUSY)) {
+                // Not written yet, or the writer is mid-copy of OUR
+                // message - it will be ready on the next poll
+                return EMPTY;
+            }
+            // A later message (or its claim) sits in our slot: lapped
+            return resync(msg);
+        }
+
+        // Copy out, then confirm the slot wasn't reclaimed mid-copy
+        msg.len = slot.len;
+        msg.hw_timestamp_ns = slot.hw_timestamp_ns;
+        msg.sequence = cursor_;
+        uint16_t copy_len = (msg.len < FanoutRing::SLOT_PAYLOAD)
+                          ? msg.len
+                          : static_cast<uint16_t>(FanoutRing::SLOT_PAYLOAD);
+        std::memcpy(msg.data, slot.payload, copy_len);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != cursor_) [[unlikely]] {
+            // Writer lapped us DURING the copy - the bytes are torn
+            return resync(msg);
+        }
+
+        cursor_++;
+        return OK;
+    }
+
+    /** How far behind the live edge this reader currently is */
+    uint64_t lag() const {
+        return header_->next_seq.load(std::memory_order_acquire) - cursor_;
+    }
+
+    uint64_t cursor() const { return cursor_; }
+
+    void close_ring() {
+        if (header_) {
+            munmap(const_cast<Header*>(header_),
+                   sizeof(Header) + (mask_ + 1) * sizeof(Slot));
+            header_ = nullptr;
+            slots_ = nullptr;
+        }
+    }
+
+private:
+    using Header = FanoutRing::Header;
+    using Slot = FanoutRing::Slot;
+
+    /**
+     * Re-anchor the cursor after a lap, keeping the salvageable backlog
+     *
+     * Jumping all the way to the live edge would discard up to a full
+     * ring of perfectly readable messages. Instead re-anchor 3/4 of a
+     * lap behind the writer: the newest backlog is kept, and the 1/4
+     * head-start means the writer won't immediately lap us again
+     * mid-copy while we drain it.
+     */
+    inline Result resync(Message& msg) {
+        const uint64_t live =
+            header_->next_seq.load(std::memory_order_acquire);
+        const uint64_t ring_len = mask_ + 1;
+        const uint64_t keep = ring_len - ring_len / 4;
+
+        uint64_t anchor = (live > keep) ? live - keep : 0;
+        if (anchor <= cursor_) {
+            anchor = cursor_ + 1;  // A lap was detected - never stand still
+        }
+
+        msg.dropped = anchor - cursor_;
+        cursor_ = anchor;
+        return GAP;
+    }
+
+    const Header* header_;
+    const Slot* slots_;
+    uint64_t mask_;
+    uint64_t cursor_;
+};
+
+} // namespace hardware
+} // namespace hft
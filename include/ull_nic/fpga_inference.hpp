@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @file fpga_inference.hpp
+ * @brief Software stand-in for the FPGA microstructure-inference engine
+ *
+ * The production inference path is a DNN compiled to RTL and clocked
+ * through a PCIe-attached FPGA (see hardware_bridge.hpp for the
+ * integration contract). This file is its SOFTWARE STUB: the same
+ * input/output shape, a fixed-weight network small enough that the
+ * whole forward pass is straight-line FP arithmetic - no branches, no
+ * allocation, no table lookups that miss - so the latency is flat
+ * (~400ns-class) and a strategy developed against the stub behaves
+ * identically, timing-wise, when the bitstream shows up.
+ *
+ * The weights are NOT trained - they are a deterministic pattern so
+ * that outputs are repeatable across builds and platforms (regression
+ * tests can assert exact values). Swapping in trained weights is a
+ * data change, not a code change.
+ *
+ * @author Krishna Bajpai (krishna@krishnabajpai.me)
+ * @date December 2025
+ */
+
+namespace hft {
+
+/**
+ * @brief Order-book microstructure features - the FPGA's input vector
+ *
+ * Eight doubles, fixed order: this layout IS the DMA wire format the
+ * hardware path copies into the feature buffer (hardware_bridge.hpp
+ * stages them in exactly this order). Add fields at the end only, and
+ * bump the FPGA-side feature count with them.
+ */
+struct MicrostructureFeatures {
+    double ofi_level_1 = 0.0;      // Order flow imbalance, top of book
+    double ofi_level_5 = 0.0;      // Order flow imbalance, 5 levels deep
+    double ofi_level_10 = 0.0;     // Order flow imbalance, 10 levels deep
+    double trade_imbalance = 0.0;  // Signed trade volume imbalance
+    double spread = 0.0;           // Best ask - best bid
+    double volatility = 0.0;       // Short-horizon realized volatility
+    double microprice = 0.0;       // Size-weighted mid price
+    double queue_imbalance = 0.0;  // Bid/ask queue depth imbalance
+};
+
+/**
+ * @brief Fixed-topology DNN forward pass (8 -> 16 -> 4, tanh hidden)
+ *
+ * Mirrors the RTL pipeline: one hidden layer the FPGA evaluates fully
+ * parallel, four linear outputs. predictions[0] is the primary signal
+ * (expected short-horizon price move); the remaining outputs are
+ * auxiliary heads (confidence, horizon, regime) the strategy layer may
+ * ignore.
+ *
+ * Thread safety: stateless after construction - concurrent predict()
+ * calls from multiple strategy threads are fine.
+ */
+class FPGA_DNN_Inference {
+public:
+    static constexpr size_t NUM_FEATURES = 8;
+    static constexpr size_t HIDDEN_UNITS = 16;
+    static constexpr size_t NUM_OUTPUTS = 4;
+
+    FPGA_DNN_Inference() {
+        // Deterministic weight pattern (placeholder for trained
+        // weights): small, sign-alternating values so every unit
+        // contributes and nothing saturates tanh
+        for (size_t h = 0; h < HIDDEN_UNITS; h++) {
+            for (size_t f = 0; f < NUM_FEATURES; f++) {
+                double v = 0.05 + 0.01 * static_cast<double>((h * NUM_FEATURES + f) % 7);
+                w1_[h][f] = ((h + f) & 1) ? -v : v;
+            }
+            b1_[h] = 0.01 * static_cast<double>(h % 3);
+        }
+        for (size_t o = 0; o < NUM_OUTPUTS; o++) {
+            for (size_t h = 0; h < HIDDEN_UNITS; h++) {
+                double v = 0.1 + 0.02 * static_cast<double>((o * HIDDEN_UNITS + h) % 5);
+                w2_[o][h] = ((o + h) & 1) ? -v : v;
+            }
+            b2_[o] = 0.0;
+        }
+    }
+
+    /**
+     * @brief Run one forward pass
+     *
+     * Straight-line arithmetic, fixed trip counts - the compiler
+     * unrolls and vectorizes this into a branch-free block, which is
+     * what makes the stub's latency deterministic.
+     *
+     * @param features Input vector (see MicrostructureFeatures)
+     * @return NUM_OUTPUTS predictions; [0] is the primary signal
+     */
+    std::array<double, NUM_OUTPUTS> predict(const MicrostructureFeatures& features) const {
+        const double in[NUM_FEATURES] = {
+            features.ofi_level_1,
+            features.ofi_level_5,
+            features.ofi_level_10,
+            features.trade_imbalance,
+            features.spread,
+            features.volatility,
+            features.microprice,
+            features.queue_imbalance,
+        };
+
+        double hidden[HIDDEN_UNITS];
+        for (size_t h = 0; h < HIDDEN_UNITS; h++) {
+            double acc = b1_[h];
+            for (size_t f = 0; f < NUM_FEATURES; f++) {
+                acc += w1_[h][f] * in[f];
+            }
+            hidden[h] = std::tanh(acc);
+        }
+
+        std::array<double, NUM_OUTPUTS> out{};
+        for (size_t o = 0; o < NUM_OUTPUTS; o++) {
+            double acc = b2_[o];
+            for (size_t h = 0; h < HIDDEN_UNITS; h++) {
+                acc += w2_[o][h] * hidden[h];
+            }
+            out[o] = acc;
+        }
+        return out;
+    }
+
+private:
+    double w1_[HIDDEN_UNITS][NUM_FEATURES];
+    double b1_[HIDDEN_UNITS];
+    double w2_[NUM_OUTPUTS][HIDDEN_UNITS];
+    double b2_[NUM_OUTPUTS];
+};
+
+} // namespace hft
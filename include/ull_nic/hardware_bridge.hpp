@@ -22,6 +22,8 @@
 
 #include "common_types.hpp"
 #include "fpga_inference.hpp"
+#include "latency_histogram.hpp"
+#include "sharded_stats.hpp"
 #include <atomic>
 #include <memory>
 #include <optional>
@@ -84,10 +86,6 @@ public:
         : mode_(mode)
         , status_(HardwareStatus::NOT_INITIALIZED)
         , software_inference_(std::make_unique<FPGA_DNN_Inference>())
-        , total_inferences_(0)
-        , hardware_failures_(0)
-        , software_fallbacks_(0)
-        , latency_sum_ns_(0.0)
     {
     }
 
@@ -136,7 +134,7 @@ public:
                 success = predict_hardware(features, prediction);
                 if (!success) {
                     // Hardware failed, record failure
-                    hardware_failures_.fetch_add(1, std::memory_order_relaxed);
+                    stats_.inc(stats_shard(), STAT_HW_FAILURES);
                     status_.store(HardwareStatus::FAILED, std::memory_order_release);
                 }
                 break;
@@ -145,7 +143,7 @@ public:
                 success = predict_hardware(features, prediction);
                 if (!success) {
                     // Hardware failed, use software fallback
-                    software_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+                    stats_.inc(stats_shard(), STAT_SW_FALLBACKS);
                     prediction = predict_software(features);
                     success = true;
                 }
@@ -157,15 +155,160 @@ public:
         const double latency_ns = std::chrono::duration<double, std::nano>(end - start).count();
         
         update_latency_stats(latency_ns);
-        total_inferences_.fetch_add(1, std::memory_order_relaxed);
+        stats_.inc(stats_shard(), STAT_INFERENCES);
         
         return prediction;
     }
 
+    // ========================================================================
+    // Pipelined Inference (submit/complete split)
+    // ========================================================================
+    //
+    // predict() stalls the CPU for the whole FPGA round trip: write
+    // features, spin on the done flag, read the result. But the feature
+    // stream produces the next input BEFORE the previous result comes
+    // back, so the round trips can overlap:
+    //
+    //     CPU:  write slot 0 | write slot 1 | read 0, write 2 | read 1 ...
+    //     FPGA:              | compute 0    | compute 1       | compute 2
+    //
+    // The DMA buffer is carved into PIPELINE_SLOTS feature/result region
+    // pairs (double buffering generalized to a small ring): the FPGA
+    // computes from slot N while the CPU fills slot N+1. Throughput
+    // roughly doubles at equal per-inference latency.
+    //
+    // Usage:
+    //     auto tok = bridge.submit_features(f);       // Non-blocking
+    //     ... build next feature vector ...
+    //     double signal;
+    //     while (!bridge.poll_result(*tok, signal)) { /* spin or work */ }
+    //
+    // Batched submission (several vectors, ONE doorbell write - the
+    // doorbell is an uncached PCIe write, the most expensive single
+    // instruction in this path):
+    //     size_t n = bridge.submit_batch(features, count, tokens);
+
+    /// Identifies one in-flight inference (slot + ABA-guarding sequence)
+    struct InferenceToken {
+        uint32_t slot;
+        uint32_t seq;
+    };
+
+    static constexpr size_t PIPELINE_SLOTS = 4;  // Power of 2
+
+    /**
+     * Write a feature vector into the next free DMA slot and kick the
+     * FPGA. Returns nullopt when all slots are in flight (the FPGA is
+     * the bottleneck - poll some results first).
+     *
+     * Production: features go to dma_buffer + slot * FEATURE_STRIDE,
+     * then ONE doorbell write with the slot index:
+     * ```cpp
+     * float* in = fpga_dma_buffer_ + slot * FEATURE_STRIDE;
+     * in[0..7] = features...;
+     * fpga_control_regs_[REG_SUBMIT] = slot;  // Doorbell
+     * ```
+     */
+    std::optional<InferenceToken> submit_features(
+            const MicrostructureFeatures& features) {
+        InferenceToken tok;
+        if (submit_batch(&features, 1, &tok) == 0) {
+            return std::nullopt;
+        }
+        return tok;
+    }
+
+    /**
+     * Submit up to `count` feature vectors with a single doorbell
+     *
+     * @param tokens Receives one token per accepted vector
+     * @return Number of vectors accepted (< count when the slot ring
+     *         fills - the remainder should be resubmitted after polling)
+     */
+    size_t submit_batch(const MicrostructureFeatures* features,
+                        size_t count, InferenceToken* tokens) {
+        size_t accepted = 0;
+        while (accepted < count) {
+            const uint32_t slot = pipe_head_ & (PIPELINE_SLOTS - 1);
+            if (pipe_slots_[slot].busy) {
+                break;  // Ring full - FPGA is behind
+            }
+
+            // Stage features into the slot's DMA region. Production:
+            // write to fpga_dma_buffer_; simulation: keep the vector so
+            // the software stub can stand in for the FPGA at poll time.
+            pipe_slots_[slot].features = features[accepted];
+            pipe_slots_[slot].submit_tsc = ull_nic::get_timestamp();
+            pipe_slots_[slot].seq = ++pipe_seq_;
+            pipe_slots_[slot].busy = true;
+
+            tokens[accepted] = InferenceToken{slot, pipe_slots_[slot].seq};
+            pipe_head_++;
+            accepted++;
+        }
+
+        if (accepted > 0) {
+            // ONE doorbell for the whole batch. Production:
+            // fpga_control_regs_[REG_SUBMIT_COUNT] = accepted;
+            // Simulation: nothing - results materialize at poll time.
+        }
+        return accepted;
+    }
+
+    /**
+     * Check one in-flight inference; non-blocking
+     *
+     * Production: reads the slot's done flag from the result region
+     * (the FPGA DMA-writes result + completion word; no register read
+     * needed on the happy path):
+     * ```cpp
+     * volatile uint32_t* done = result_region(slot) + DONE_OFFSET;
+     * if (*done != token.seq) return false;      // Still computing
+     * prediction = result_region(slot)[0];
+     * ```
+     *
+     * @return true and fills `prediction` once the slot completed;
+     *         false while still in flight. A stale token (slot already
+     *         reused) returns false forever - poll in submission order.
+     */
+    bool poll_result(const InferenceToken& token, double& prediction) {
+        PipelineSlot& slot = pipe_slots_[token.slot & (PIPELINE_SLOTS - 1)];
+        if (!slot.busy || slot.seq != token.seq) {
+            return false;  // Stale token or never submitted
+        }
+
+        // Simulation: the software stub stands in for the FPGA, so the
+        // result is ready on first poll. Production polls the DMA
+        // completion word written by the FPGA.
+        prediction = predict_software(slot.features);
+
+        // Same bookkeeping as predict(): count the inference AND record
+        // its latency, measured submit -> completion from the TSC stamp
+        // taken in submit_batch(). Counting without recording would
+        // drag the mean (sum / count) toward zero as pipeline traffic
+        // grows, and meets_latency_sla() would pass on bogus numbers.
+        const uint64_t lat_ns = ull_nic::tsc_clock().to_ns(
+            ull_nic::get_timestamp() - slot.submit_tsc);
+        update_latency_stats(static_cast<double>(lat_ns));
+
+        slot.busy = false;
+        stats_.inc(stats_shard(), STAT_INFERENCES);
+        return true;
+    }
+
+    /** In-flight inferences (0 .. PIPELINE_SLOTS) */
+    size_t pipeline_depth() const {
+        size_t n = 0;
+        for (size_t i = 0; i < PIPELINE_SLOTS; i++) {
+            n += pipe_slots_[i].busy ? 1 : 0;
+        }
+        return n;
+    }
+
     // ========================================================================
     // Hardware Management
     // ========================================================================
-    
+
     // Switch accelerator mode at runtime (hot-swap)
     bool set_mode(AcceleratorMode new_mode) {
         if (new_mode == mode_.load(std::memory_order_acquire)) {
@@ -182,23 +325,39 @@ public:
     }
     
     // Get latency statistics for monitoring
+    // Percentiles come from the log-bucketed histogram the hot path
+    // records into - extraction walks the (snapshotted) counters here,
+    // never on the inference path
     HardwareLatencyStats get_latency_stats() const {
-        const uint64_t count = total_inferences_.load(std::memory_order_acquire);
+        // Reader-side aggregation: sum/max the per-thread shards here,
+        // on the monitoring thread - the inference path only did plain
+        // stores into its own cache line
+        const uint64_t count = stats_.sum(STAT_INFERENCES);
         if (count == 0) {
             return {0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0};
         }
-        
+
+        ull_nic::LatencyHistogram snap;
+        latency_histogram_.snapshot(snap);
+
         return {
-            latency_sum_ns_.load(std::memory_order_acquire) / count,  // Mean
-            0.0,  // P50 (requires histogram, omitted for simplicity)
-            0.0,  // P95
-            0.0,  // P99
-            max_latency_ns_.load(std::memory_order_acquire),
+            static_cast<double>(stats_.sum(STAT_LAT_SUM_NS)) / count,  // Mean
+            static_cast<double>(snap.percentile(50.0)),
+            static_cast<double>(snap.percentile(95.0)),
+            static_cast<double>(snap.percentile(99.0)),
+            static_cast<double>(stats_.max(STAT_LAT_MAX_NS)),
             count,
-            hardware_failures_.load(std::memory_order_acquire),
-            software_fallbacks_.load(std::memory_order_acquire)
+            stats_.sum(STAT_HW_FAILURES),
+            stats_.sum(STAT_SW_FALLBACKS)
         };
     }
+
+    // Full tail distribution (P99.9/P99.99) for deeper analysis
+    ull_nic::LatencyHistogram::Percentiles get_latency_percentiles() const {
+        ull_nic::LatencyHistogram snap;
+        latency_histogram_.snapshot(snap);
+        return snap.get_percentiles();
+    }
     
     // Check if inference latency meets SLA (400ns for software, configurable for hardware)
     bool meets_latency_sla(double sla_ns = 400.0) const {
@@ -381,8 +540,10 @@ private:
         // Timeout - hardware not responding
         return false;
         */
-        
+
         // Development mode: hardware not available
+        (void)features;
+        (void)prediction;
         return false;
     }
     
@@ -391,21 +552,17 @@ private:
     // ========================================================================
     
     void update_latency_stats(double latency_ns) {
-        // Atomic double addition using CAS loop
-        double old_val = latency_sum_ns_.load(std::memory_order_relaxed);
-        while (!latency_sum_ns_.compare_exchange_weak(old_val, old_val + latency_ns,
-                                                       std::memory_order_relaxed)) {
-            // Retry on failure
-        }
-        
-        // Update max latency (simple atomic max)
-        double current_max = max_latency_ns_.load(std::memory_order_relaxed);
-        while (latency_ns > current_max) {
-            if (max_latency_ns_.compare_exchange_weak(current_max, latency_ns,
-                                                      std::memory_order_relaxed)) {
-                break;
-            }
-        }
+        // Full distribution for tail analysis (fixed-size, no allocation)
+        latency_histogram_.record(static_cast<uint64_t>(latency_ns));
+
+        // Sharded sum + max: plain stores into this thread's own cache
+        // line. The CAS loops this replaces were contended RMWs on a
+        // line shared by every strategy thread.
+        const size_t shard = stats_shard();
+        stats_.add(shard, STAT_LAT_SUM_NS,
+                   static_cast<uint64_t>(latency_ns));
+        stats_.record_max(shard, STAT_LAT_MAX_NS,
+                          static_cast<uint64_t>(latency_ns));
     }
 
     // ========================================================================
@@ -424,12 +581,49 @@ private:
     // volatile uint32_t* fpga_control_regs_; // Memory-mapped control registers
     // float* fpga_dma_buffer_;               // DMA buffer for features/predictions
     
-    // Statistics
-    std::atomic<uint64_t> total_inferences_;
-    std::atomic<uint64_t> hardware_failures_;
-    std::atomic<uint64_t> software_fallbacks_;
-    std::atomic<double> latency_sum_ns_;
-    std::atomic<double> max_latency_ns_;
+    // ========================================================================
+    // Statistics: cache-line-sharded counters, one shard per calling
+    // thread (strategy threads register lazily via this_thread_shard).
+    // Cells are either running sums or running maxima - see the enum.
+    // ========================================================================
+    enum StatIndex : size_t {
+        STAT_INFERENCES = 0,
+        STAT_HW_FAILURES,
+        STAT_SW_FALLBACKS,
+        STAT_LAT_SUM_NS,     // Running sum (ns, truncated to integer)
+        STAT_LAT_MAX_NS,     // Running max via record_max()
+        STAT_COUNT
+    };
+
+    static constexpr size_t STAT_SHARDS = 8;
+
+    static size_t stats_shard() {
+        return ull_nic::this_thread_shard(STAT_SHARDS);
+    }
+
+    ull_nic::ShardedCounters<STAT_COUNT, STAT_SHARDS> stats_;
+
+    // ========================================================================
+    // Pipelined inference state: a small ring of DMA slot descriptors.
+    // In production each slot maps a feature region and a result region
+    // in the XDMA buffer; in simulation the staged features feed the
+    // software stub at poll time.
+    // ========================================================================
+    struct PipelineSlot {
+        MicrostructureFeatures features;  // Staged input (sim stand-in
+                                          // for the DMA feature region)
+        uint64_t submit_tsc = 0;          // Stamped at submit; poll_result
+                                          // records submit->complete latency
+        uint32_t seq = 0;                 // Guards against stale tokens
+        bool busy = false;                // Submitted, result not polled
+    };
+
+    PipelineSlot pipe_slots_[PIPELINE_SLOTS];
+    uint64_t pipe_head_ = 0;              // Next slot to fill
+    uint32_t pipe_seq_ = 0;               // Monotonic submission counter
+
+    // Log-bucketed latency distribution (min/max/avg hides the tail)
+    ull_nic::LatencyHistogram latency_histogram_;
 };
 
 // ============================================================================
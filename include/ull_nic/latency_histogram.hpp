@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+
+/**
+ * @file latency_histogram.hpp
+ * @brief Log-bucketed latency histogram for hot-path instrumentation
+ *
+ * Why min/max/avg is not enough:
+ * ─────────────────────────────
+ *
+ * Averages HIDE tail latency. A path that does 50ns for 99.9% of packets
+ * and 10us for the other 0.1% averages ~60ns - and that 10us hiccup is
+ * exactly the event we chase. Tail analysis needs a full distribution:
+ * P50 / P99 / P99.9 / P99.99.
+ *
+ * Design constraints for recording INSIDE the polling loop:
+ * - No allocation on record (fixed-size array, sized at compile time)
+ * - Cache-resident (~8KB - fits in L1/L2 alongside the ring)
+ * - Record cost: one clz, one shift, one increment (~2-3 ns)
+ * - Reader never blocks the writer: a control thread copies the counter
+ *   array (snapshot) and computes percentiles off-core
+ *
+ * Bucketing: HDR-style log-linear. Each power-of-two range ("octave") is
+ * split into 16 linear sub-buckets, giving a worst-case value error of
+ * ~6% - plenty for percentile reporting across ns..seconds.
+ */
+
+namespace ull_nic {
+
+class LatencyHistogram {
+public:
+    static constexpr size_t LOG_SUB_BUCKETS = 4;   // 16 sub-buckets/octave
+    static constexpr size_t SUB_BUCKETS = 1u << LOG_SUB_BUCKETS;
+    static constexpr size_t NUM_BUCKETS = 1024;    // Covers full uint64 range
+
+    /**
+     * @brief Extracted percentile summary (values in the recorded unit,
+     *        typically nanoseconds)
+     */
+    struct Percentiles {
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t p999;    // P99.9
+        uint64_t p9999;   // P99.99
+        uint64_t min;
+        uint64_t max;
+        uint64_t count;
+    };
+
+    LatencyHistogram() { reset(); }
+
+    /**
+     * @brief Record one sample (HOT PATH - no allocation, no branches
+     *        beyond the small-value fast case)
+     *
+     * Performance: ~2-3 ns (clz + shift + increment)
+     *
+     * @param value Sample in nanoseconds (or any consistent unit)
+     */
+    inline void record(uint64_t value) {
+        counts_[bucket_for(value)]++;
+        count_++;
+        if (value < min_) min_ = value;
+        if (value > max_) max_ = value;
+    }
+
+    /**
+     * @brief Copy the counters for off-core analysis
+     *
+     * The polling thread keeps recording while the control thread copies;
+     * a snapshot may be one sample "torn" - irrelevant for percentiles.
+     */
+    void snapshot(LatencyHistogram& out) const {
+        std::memcpy(out.counts_, counts_, sizeof(counts_));
+        out.count_ = count_;
+        out.min_ = min_;
+        out.max_ = max_;
+    }
+
+    /**
+     * @brief Value at percentile p (0.0 - 100.0)
+     *
+     * Walk the cumulative counts to the target rank and reconstruct the
+     * bucket's representative value. Call from a control thread (or on a
+     * snapshot) - cost is O(NUM_BUCKETS), not hot-path safe.
+     */
+    uint64_t percentile(double p) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>((p / 100.0) * count_);
+        if (target >= count_) {
+            target = count_ - 1;
+        }
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            cumulative += counts_[i];
+            if (cumulative > target) {
+                return value_for(i);
+            }
+        }
+        return max_;
+    }
+
+    /**
+     * @brief Extract the standard tail-analysis percentile set
+     */
+    Percentiles get_percentiles() const {
+        return {
+            percentile(50.0),
+            percentile(99.0),
+            percentile(99.9),
+            percentile(99.99),
+            (count_ > 0) ? min_ : 0,
+            max_,
+            count_
+        };
+    }
+
+    /**
+     * @brief Dump percentiles (control thread; does not stop the recorder)
+     */
+    void dump(const char* label = "latency", FILE* out = stdout) const {
+        Percentiles p = get_percentiles();
+        fprintf(out,
+                "%s: n=%llu min=%llu p50=%llu p99=%llu "
+                "p99.9=%llu p99.99=%llu max=%llu\n",
+                label,
+                static_cast<unsigned long long>(p.count),
+                static_cast<unsigned long long>(p.min),
+                static_cast<unsigned long long>(p.p50),
+                static_cast<unsigned long long>(p.p99),
+                static_cast<unsigned long long>(p.p999),
+                static_cast<unsigned long long>(p.p9999),
+                static_cast<unsigned long long>(p.max));
+    }
+
+    uint64_t count() const { return count_; }
+
+    void reset() {
+        std::memset(counts_, 0, sizeof(counts_));
+        count_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+private:
+    uint64_t counts_[NUM_BUCKETS];
+    uint64_t count_;
+    uint64_t min_;
+    uint64_t max_;
+
+    /**
+     * @brief Log-linear bucket index (HDR-style)
+     */
+    static inline uint32_t bucket_for(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<uint32_t>(value);  // Exact small values
+        }
+        uint32_t msb = 63 - __builtin_clzll(value);
+        uint32_t shift = msb - LOG_SUB_BUCKETS;
+        uint32_t idx = ((shift + 1) << LOG_SUB_BUCKETS) +
+                       ((value >> shift) & (SUB_BUCKETS - 1));
+        return (idx < NUM_BUCKETS) ? idx : NUM_BUCKETS - 1;
+    }
+
+    /**
+     * @brief Representative (midpoint) value for a bucket index
+     */
+    static inline uint64_t value_for(size_t idx) {
+        if (idx < SUB_BUCKETS) {
+            return idx;
+        }
+        uint64_t shift = (idx >> LOG_SUB_BUCKETS) - 1;
+        uint64_t sub = idx & (SUB_BUCKETS - 1);
+        uint64_t base = (SUB_BUCKETS + sub) << shift;
+        return base + (1ULL << shift) / 2;  // Bucket midpoint
+    }
+};
+
+} // namespace ull_nic
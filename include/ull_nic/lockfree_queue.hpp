@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+/**
+ * @file lockfree_queue.hpp
+ * @brief Single-producer/single-consumer lock-free ring buffer
+ *
+ * The queue between the NIC polling thread (producer) and the strategy
+ * thread (consumer). Design points that matter at tick rates:
+ *
+ * 1. SPSC, not MPMC. One producer, one consumer means no CAS loops -
+ *    each side owns its cursor and only LOADS the other side's. Push and
+ *    pop are a handful of instructions.
+ *
+ * 2. Cursors on separate cache lines. head_ (consumer-owned) and tail_
+ *    (producer-owned) each get their own 64-byte line. Without the
+ *    padding both cursors share a line and every push invalidates the
+ *    consumer's cached copy (false sharing - visible as HITM events in
+ *    `perf c2c`).
+ *
+ * 3. Cached peer cursors. The producer keeps a stale copy of head_ and
+ *    only re-reads the real (contended) atomic when the cached value
+ *    says "full" - ditto the consumer with tail_. In steady state each
+ *    side touches ONLY its own cache lines.
+ *
+ * 4. Batch transfer. pop_batch()/push_batch() move a whole burst with
+ *    ONE acquire load and ONE release store, memcpy-ing the contiguous
+ *    ring segments. Draining 200 ticks costs one synchronization
+ *    round-trip instead of 200.
+ *
+ * Capacity must be a power of 2 so index wrap is a mask, not a divide.
+ */
+
+namespace hft {
+
+template<typename T, size_t Capacity>
+class LockFreeQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be power of 2");
+
+public:
+    LockFreeQueue() : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    // ========================================================================
+    // Producer side
+    // ========================================================================
+
+    /**
+     * Push one element (producer thread only)
+     *
+     * Performance: ~5-10 ns uncontended (one relaxed load, one store,
+     * one release store; the acquire re-load of head_ only happens when
+     * the cached copy says the ring looks full)
+     */
+    bool push(const T& item) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= Capacity) [[unlikely]] {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= Capacity) {
+                return false;  // Genuinely full
+            }
+        }
+
+        buffer_[tail & MASK] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Move-construct one element in place (producer thread only)
+     */
+    bool emplace(T&& item) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= Capacity) [[unlikely]] {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= Capacity) {
+                return false;
+            }
+        }
+
+        buffer_[tail & MASK] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Construct one element directly in the ring slot (producer thread only)
+     *
+     * The zero-copy producer path: instead of building a T on the stack
+     * and copying it in, the caller's functor writes straight into the
+     * slot the consumer will eventually read. A protocol decoder parsing
+     * a DMA buffer uses this to go NIC memory -> queue slot with no
+     * intermediate MarketTick anywhere.
+     *
+     * The functor receives `T&` and returns bool; the slot is published
+     * (tail advanced) only when it returns true, so a decoder can bail
+     * on a malformed packet and the half-written slot is simply reused
+     * by the next call. The consumer never observes it.
+     *
+     * @return true if the functor succeeded and the slot was published
+     */
+    template<typename FillFn>
+    bool produce_in_place(FillFn&& fill) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= Capacity) [[unlikely]] {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= Capacity) {
+                return false;  // Genuinely full
+            }
+        }
+
+        if (!fill(buffer_[tail & MASK])) [[unlikely]] {
+            return false;  // Decode failed - slot never published
+        }
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Push up to `count` elements as one batch (producer thread only)
+     *
+     * One cursor advance for the whole batch: the consumer sees either
+     * none or all of it. The copy is at most two memcpy calls - the
+     * segment up to the ring end, then the wrapped remainder.
+     *
+     * @return Number of elements actually enqueued (< count if the ring
+     *         filled up)
+     */
+    size_t push_batch(const T* items, size_t count) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+
+        uint64_t free_slots = Capacity - (tail - cached_head_);
+        if (free_slots < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free_slots = Capacity - (tail - cached_head_);
+        }
+
+        const size_t n = (count < free_slots) ? count : free_slots;
+        if (n == 0) [[unlikely]] {
+            return 0;
+        }
+
+        // Copy contiguous segments (at most one wrap)
+        const size_t start = tail & MASK;
+        const size_t first = (n < Capacity - start) ? n : Capacity - start;
+        std::memcpy(&buffer_[start], items, first * sizeof(T));
+        if (n > first) {
+            std::memcpy(&buffer_[0], items + first, (n - first) * sizeof(T));
+        }
+
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // ========================================================================
+    // Consumer side
+    // ========================================================================
+
+    /**
+     * Pop one element (consumer thread only)
+     */
+    bool pop(T& item) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) [[unlikely]] {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;  // Genuinely empty
+            }
+        }
+
+        item = buffer_[head & MASK];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop up to `max` elements as one batch (consumer thread only)
+     *
+     * The whole drain costs ONE acquire load of tail_ and ONE release
+     * store of head_, regardless of how many elements move. This is the
+     * call the strategy loop should use during bursts - draining a
+     * 200-tick open with pop() pays 200 synchronization round-trips;
+     * with pop_batch() it pays one.
+     *
+     * @return Number of elements copied into `out`
+     */
+    size_t pop_batch(T* out, size_t max) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+
+        uint64_t available = cached_tail_ - head;
+        if (available < max) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            available = cached_tail_ - head;
+        }
+
+        const size_t n = (max < available) ? max : available;
+        if (n == 0) [[unlikely]] {
+            return 0;
+        }
+
+        // Copy contiguous segments (at most one wrap)
+        const size_t start = head & MASK;
+        const size_t first = (n < Capacity - start) ? n : Capacity - start;
+        std::memcpy(out, &buffer_[start], first * sizeof(T));
+        if (n > first) {
+            std::memcpy(out + first, &buffer_[0], (n - first) * sizeof(T));
+        }
+
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Peek at the next element without removing it (consumer thread only)
+     *
+     * @return Pointer into the ring (valid until the next pop), or
+     *         nullptr if empty
+     */
+    const T* peek() const {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &buffer_[head & MASK];
+    }
+
+    // ========================================================================
+    // Observers (approximate under concurrent access - fine for stats)
+    // ========================================================================
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint64_t MASK = Capacity - 1;
+
+    // Consumer-owned cursor + the consumer's stale copy of tail_
+    alignas(64) std::atomic<uint64_t> head_;
+    uint64_t cached_tail_;
+
+    // Producer-owned cursor + the producer's stale copy of head_
+    alignas(64) std::atomic<uint64_t> tail_;
+    uint64_t cached_head_;
+
+    // Element storage on its own line so cursor traffic never aliases it
+    alignas(64) T buffer_[Capacity];
+};
+
+} // namespace hft
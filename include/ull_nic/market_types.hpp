@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @file market_types.hpp
+ * @brief Market data types shared by the kernel-bypass ingestion path
+ *
+ * These are the types that flow through the lock-free tick queue. The
+ * layout rules matter more than the fields:
+ *
+ * - MarketTick is trivially copyable: the queue moves ticks with memcpy
+ *   (pop_batch/push_batch) and protocol decoders construct them
+ *   in-place inside DMA-adjacent memory.
+ * - Cache-line aligned so a tick never straddles lines in the ring.
+ * - Fixed-size LOB arrays (no pointers!) - the tick is self-contained
+ *   and crosses thread/process boundaries without ownership questions.
+ */
+
+namespace hft {
+
+/**
+ * Trade aggressor side
+ */
+enum class Side : uint8_t {
+    BUY = 0,
+    SELL = 1
+};
+
+/**
+ * One normalized market data update (top-of-book + depth)
+ *
+ * This is the unit the strategy loop consumes; every exchange protocol
+ * decodes into this shape.
+ */
+struct alignas(64) MarketTick {
+    static constexpr size_t MAX_DEPTH = 10;
+
+    uint64_t timestamp;       // Receive timestamp (ns, kernel-bypass stamped)
+    uint32_t asset_id;        // Internal instrument id
+    uint8_t depth_levels;     // Valid LOB levels (<= MAX_DEPTH)
+    Side trade_side;          // Aggressor side of the triggering trade
+
+    double mid_price;
+    double bid_price;         // Best bid
+    double ask_price;         // Best ask
+    uint32_t bid_size;        // Best bid size
+    uint32_t ask_size;        // Best ask size
+    uint32_t trade_volume;    // Size of the triggering trade (0 = quote)
+
+    // Limit order book depth (fixed arrays - trivially copyable)
+    double bid_prices[MAX_DEPTH];
+    double ask_prices[MAX_DEPTH];
+    uint32_t bid_sizes[MAX_DEPTH];
+    uint32_t ask_sizes[MAX_DEPTH];
+};
+
+static_assert(sizeof(MarketTick) % 64 == 0,
+              "MarketTick must be a whole number of cache lines");
+
+/**
+ * Nanosecond timestamp for tick stamping
+ *
+ * Uses the monotonic-ish high_resolution_clock - adequate for ordering
+ * and coarse latency. Hot-path measurement should use get_timestamp()
+ * (RDTSC) from common_types.hpp instead.
+ */
+inline uint64_t now() {
+    auto t = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        t.time_since_epoch()
+    ).count();
+}
+
+} // namespace hft
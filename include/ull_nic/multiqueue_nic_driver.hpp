@@ -0,0 +1,412 @@
+#pragma once
+
+#include "custom_nic_driver.hpp"
+#include "dma_arena.hpp"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <pthread.h>
+
+/**
+ * Multi-Queue RSS NIC Driver
+ *
+ * Why multi-queue:
+ * ────────────────
+ *
+ * One core polling one RX ring tops out around 14 Mpps - fine for a single
+ * 10GbE market-data feed, nowhere near enough for 100GbE capture. The fix
+ * is the same one every modern NIC implements in hardware:
+ *
+ * 1. NIC hashes each packet's 5-tuple (RSS - Receive Side Scaling)
+ * 2. Hash indexes an indirection table that selects one of N RX queues
+ * 3. Each queue DMAs into its own descriptor ring
+ * 4. One dedicated core drains each ring - queues never share cache lines
+ *
+ * Result: throughput scales near-linearly with queue count
+ * (4 queues ≈ 50+ Mpps, 8 queues saturate 100GbE at 64-byte packets).
+ *
+ * Register layout:
+ * ───────────────
+ *
+ * Queue N's registers live at the queue-0 offsets from `namespace reg`
+ * plus N * reg::QUEUE_STRIDE (matches the per-queue register banks on
+ * Intel X710 / i40e class hardware).
+ *
+ * NUMA placement:
+ * ──────────────
+ *
+ * Each queue's ring and packet buffers are allocated from INSIDE its
+ * pinned polling thread AND mbind'ed to that core's node (see
+ * numa_placement.hpp) - first-touch alone is a heuristic that breaks
+ * when the local node is full; the explicit bind makes per-queue
+ * placement policy. On dual-socket hosts this avoids a ~60ns
+ * per-packet remote-node penalty.
+ *
+ * Usage:
+ * ```cpp
+ * MultiQueueNICDriver nic;
+ * nic.initialize("/sys/bus/pci/devices/0000:01:00.0/resource0", 4);
+ * int cores[] = {2, 3, 4, 5};  // isolated cores
+ * nic.start_polling(cores, [](size_t queue, const RxView* pkts, size_t n) {
+ *     process_burst(queue, pkts, n);
+ * });
+ * ```
+ */
+
+namespace hft {
+namespace hardware {
+
+namespace reg {
+    // Per-queue register bank stride: queue N register = queue-0 offset
+    // + N * QUEUE_STRIDE (i40e-style queue register banks)
+    constexpr uint64_t QUEUE_STRIDE   = 0x100;
+
+    // RSS (Receive Side Scaling) registers
+    constexpr uint64_t RSS_KEY_BASE   = 0x6800;  // 40-byte hash key
+    constexpr uint64_t RSS_TABLE_BASE = 0x6C00;  // 128-entry indirection table
+}
+
+// Maximum hardware RX/TX queue pairs we program
+constexpr size_t MAX_RX_QUEUES = 16;
+
+// RSS indirection table size (fixed on i40e-class hardware)
+constexpr size_t RSS_TABLE_ENTRIES = 128;
+
+/**
+ * MultiQueueNICDriver: N RX/TX queue pairs, one polling core per queue
+ *
+ * Scales CustomNICDriver's single-ring model to multiple hardware queues.
+ * Each queue is an independent descriptor ring with its own software head,
+ * its own DMA buffers, and its own polling thread - no shared state on the
+ * hot path, so no cross-core cache-line bouncing.
+ */
+class MultiQueueNICDriver {
+public:
+    MultiQueueNICDriver()
+        : bar0_base_(nullptr)
+        , num_queues_(0)
+        , running_(false)
+    {}
+
+    ~MultiQueueNICDriver() {
+        stop();
+        for (size_t q = 0; q < num_queues_; q++) {
+            teardown_queue(q);
+        }
+    }
+
+    MultiQueueNICDriver(const MultiQueueNICDriver&) = delete;
+    MultiQueueNICDriver& operator=(const MultiQueueNICDriver&) = delete;
+
+    /**
+     * Map BAR0 and program the RSS engine for num_queues queues
+     *
+     * Ring and buffer allocation is deferred to start_polling() so memory
+     * is first-touched by the pinned polling thread (NUMA-local).
+     *
+     * @param pci_device PCI resource path (e.g., ".../0000:01:00.0/resource0")
+     * @param num_queues Number of RX/TX queue pairs (1-16)
+     * @return true if successful
+     */
+    bool initialize(const char* pci_device, size_t num_queues) {
+        if (num_queues == 0 || num_queues > MAX_RX_QUEUES) [[unlikely]] {
+            return false;
+        }
+
+        int fd = open(pci_device, O_RDWR | O_SYNC);
+        if (fd < 0) [[unlikely]] {
+            return false;
+        }
+
+        size_t bar0_size = 0x800000;  // 8 MB (typical NIC BAR size)
+        bar0_base_ = static_cast<volatile uint8_t*>(
+            mmap(nullptr, bar0_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+        );
+        close(fd);
+
+        if (bar0_base_ == MAP_FAILED) [[unlikely]] {
+            return false;
+        }
+
+        num_queues_ = num_queues;
+
+        // Program RSS so hardware actually spreads flows across our queues
+        configure_rss();
+
+        return true;
+    }
+
+    /**
+     * Program the RSS hash key and indirection table
+     *
+     * Generalizes BroadcomNetXtreme::configure_rss() onto the reg:: map:
+     * same round-robin indirection scheme, but the table entries now drive
+     * queues that this driver actually consumes.
+     */
+    void configure_rss() {
+        // Toeplitz hash key (fixed pseudo-random pattern; symmetric keys
+        // matter only if you need bidirectional flow affinity)
+        for (int i = 0; i < 10; i++) {
+            write_reg32(reg::RSS_KEY_BASE + (i * 4), 0x6b + (i * 0x1f3d));
+        }
+
+        // Round-robin indirection: hash % table_size -> queue
+        for (size_t i = 0; i < RSS_TABLE_ENTRIES; i++) {
+            write_reg32(reg::RSS_TABLE_BASE + (i * 4),
+                        static_cast<uint32_t>(i % num_queues_));
+        }
+    }
+
+    /**
+     * Poll one queue for a burst of packets (per-queue hot path)
+     *
+     * Same amortized-MMIO contract as CustomNICDriver::poll_rx_burst():
+     * one RX_HEAD read, DD-bit scan in cached ring memory, one RX_TAIL
+     * doorbell. Each queue has independent cursors - safe to call from
+     * one thread per queue with zero synchronization.
+     *
+     * @param queue Queue index (0 .. num_queues-1)
+     * @param out Array of RxView to fill
+     * @param max Maximum packets to drain
+     * @return Number of packets received
+     */
+    inline size_t poll_rx_burst(size_t queue, RxView* out, size_t max) {
+        RxQueue& q = queues_[queue];
+
+        uint32_t hw_head = read_reg32(rx_reg(reg::RX_HEAD, queue));
+        if (hw_head == q.head) [[unlikely]] {
+            return 0;
+        }
+
+        size_t n = 0;
+        while (n < max) {
+            RXDescriptor& desc = q.ring[q.head];
+            if (!(desc.status_flags & RX_DD_BIT)) [[unlikely]] {
+                break;
+            }
+
+            out[n].data = q.buffers[q.head];
+            out[n].len = desc.pkt_len;
+            out[n].hw_timestamp_ns = desc.timestamp;  // PHC writeback stamp
+            desc.status_flags = 0;
+
+            q.head = (q.head + 1) & (RX_RING_SIZE - 1);
+            n++;
+        }
+
+        if (n == 0) [[unlikely]] {
+            // Head register outran the DD writeback (PCIe posts them
+            // independently). Nothing was consumed, so there are no
+            // buffers to hand back - ringing the doorbell here would be
+            // a wasted serializing MMIO store every such poll.
+            return 0;
+        }
+
+        write_reg32(rx_reg(reg::RX_TAIL, queue), q.head);
+        return n;
+    }
+
+    /**
+     * Spawn one pinned polling thread per queue
+     *
+     * Each thread:
+     * 1. Pins itself to cores[queue] (ideally an isolcpus core)
+     * 2. Allocates its queue's ring + buffers (first-touch = NUMA-local)
+     * 3. Programs the queue's hardware registers
+     * 4. Busy-polls poll_rx_burst() until stop()
+     *
+     * @param cores Array of num_queues CPU core ids, one per queue
+     * @param callback Invoked with (queue, const RxView*, count) per burst
+     * @return true if threads were started
+     */
+    template<typename Callback>
+    bool start_polling(const int* cores, Callback callback) {
+        if (!bar0_base_ || running_.exchange(true)) [[unlikely]] {
+            return false;
+        }
+
+        for (size_t q = 0; q < num_queues_; q++) {
+            pollers_.emplace_back([this, q, core = cores[q], callback]() {
+                pin_to_core(core);
+
+                // Allocate on THIS thread (first-touch) and bind each
+                // queue's memory to the polling core's node (policy)
+                if (!setup_queue(q, node_of_cpu(core))) {
+                    return;
+                }
+                program_rx_queue(q);
+
+                RxView views[CustomNICDriver<>::MAX_RX_BURST];
+                while (running_.load(std::memory_order_relaxed)) {
+                    size_t n = poll_rx_burst(q, views, CustomNICDriver<>::MAX_RX_BURST);
+                    if (n > 0) [[likely]] {
+                        callback(q, static_cast<const RxView*>(views), n);
+                    }
+                    // NO SLEEP - dedicated core per queue
+                }
+            });
+        }
+
+        return true;
+    }
+
+    /**
+     * Stop polling threads and join them
+     */
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        for (auto& t : pollers_) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+        pollers_.clear();
+    }
+
+    size_t num_queues() const { return num_queues_; }
+
+    /**
+     * One queue's DMA arena (rings + packet buffers)
+     *
+     * Empty until the queue's polling thread has run setup_queue().
+     * Exposed for the same reason as CustomNICDriver::dma_arena(): the
+     * device side of a simulated BAR0 learns its bus->host translations
+     * from here.
+     */
+    const DmaArena& queue_arena(size_t queue) const {
+        return queues_[queue].arena;
+    }
+
+private:
+    /**
+     * Per-queue state, cache-line aligned so adjacent queues' cursors
+     * never false-share (each queue is owned by exactly one core)
+     */
+    struct alignas(64) RxQueue {
+        RXDescriptor* ring = nullptr;
+        uint8_t* buffers[RX_RING_SIZE] = {};
+        uint32_t head = 0;
+        DmaArena arena;  // Owns the ring and every buffer above
+    };
+
+    volatile uint8_t* bar0_base_;
+    size_t num_queues_;
+    std::atomic<bool> running_;
+    RxQueue queues_[MAX_RX_QUEUES];
+    std::vector<std::thread> pollers_;
+
+    // Queue-N register address from the queue-0 offset
+    static constexpr uint64_t rx_reg(uint64_t queue0_offset, size_t queue) {
+        return queue0_offset + queue * reg::QUEUE_STRIDE;
+    }
+
+    inline uint32_t read_reg32(uint64_t offset) const {
+        return *reinterpret_cast<volatile uint32_t*>(bar0_base_ + offset);
+    }
+
+    inline void write_reg32(uint64_t offset, uint32_t value) {
+        *reinterpret_cast<volatile uint32_t*>(bar0_base_ + offset) = value;
+        #if defined(__x86_64__) || defined(__i386__)
+        __asm__ __volatile__("mfence" ::: "memory");
+        #else
+        __sync_synchronize();
+        #endif
+    }
+
+    /**
+     * Pin the calling thread to one core (Linux)
+     */
+    static void pin_to_core(int core) {
+        #ifdef __linux__
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(core, &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        #else
+        (void)core;
+        #endif
+    }
+
+    /**
+     * Allocate ring + packet buffers for one queue
+     *
+     * Same arena layout as CustomNICDriver::initialize(), but one arena
+     * PER QUEUE: a single NUMA-bound reservation carved into the ring
+     * and its buffers, with physical addresses cached at creation (no
+     * pagemap syscall per translation). Called from the queue's pinned
+     * polling thread and bound to `node`, so each queue's memory lands
+     * on its polling core's socket by policy, not first-touch luck.
+     *
+     * The single backing mapping also makes partial failure trivial to
+     * unwind: teardown_queue() releases everything this queue ever
+     * allocated, so a failed queue never leaks its earlier carves.
+     *
+     * @param node NUMA node of the queue's polling core (-1 = no bind)
+     */
+    bool setup_queue(size_t queue, int node = -1) {
+        RxQueue& q = queues_[queue];
+
+        size_t arena_size =
+            RX_RING_SIZE * sizeof(RXDescriptor) +
+            RX_RING_SIZE * PACKET_BUFFER_SIZE +
+            DmaArena::HUGE_PAGE_SIZE;  // Alignment slack
+
+        if (!q.arena.create(arena_size, node)) [[unlikely]] {
+            return false;
+        }
+
+        q.ring = q.arena.alloc<RXDescriptor>(RX_RING_SIZE);
+        if (!q.ring) [[unlikely]] {
+            teardown_queue(queue);
+            return false;
+        }
+
+        for (size_t i = 0; i < RX_RING_SIZE; i++) {
+            q.buffers[i] = q.arena.alloc<uint8_t>(PACKET_BUFFER_SIZE);
+            if (!q.buffers[i]) [[unlikely]] {
+                teardown_queue(queue);
+                return false;
+            }
+            q.ring[i].buffer_addr = q.arena.virt_to_phys(q.buffers[i]);
+            q.ring[i].status = 0;
+        }
+
+        return true;
+    }
+
+    /**
+     * Release one queue's memory (arena + derived pointers)
+     *
+     * Safe on a partially set-up queue - everything the queue owns
+     * lives in its arena, so one destroy() unwinds any prefix of
+     * setup_queue().
+     */
+    void teardown_queue(size_t queue) {
+        RxQueue& q = queues_[queue];
+        q.arena.destroy();
+        q.ring = nullptr;
+        for (size_t i = 0; i < RX_RING_SIZE; i++) {
+            q.buffers[i] = nullptr;
+        }
+        q.head = 0;
+    }
+
+    /**
+     * Program one queue's hardware ring registers
+     */
+    void program_rx_queue(size_t queue) {
+        RxQueue& q = queues_[queue];
+        uint64_t ring_phys = q.arena.virt_to_phys(q.ring);
+
+        write_reg32(rx_reg(reg::RX_BASE_LO, queue), ring_phys & 0xFFFFFFFF);
+        write_reg32(rx_reg(reg::RX_BASE_HI, queue), ring_phys >> 32);
+        write_reg32(rx_reg(reg::RX_LEN, queue),
+                    RX_RING_SIZE * sizeof(RXDescriptor));
+        write_reg32(rx_reg(reg::RX_HEAD, queue), 0);
+        write_reg32(rx_reg(reg::RX_TAIL, queue), RX_RING_SIZE - 1);
+    }
+
+};
+
+} // namespace hardware
+} // namespace hft
@@ -0,0 +1,510 @@
+#pragma once
+
+#include "kernel_bypass_nic.hpp"
+#include "common_types.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @file pcap_replay.hpp
+ * @brief Memory-mapped pcap/pcapng replay engine for KernelBypassNIC
+ *
+ * Replays a real capture - Friday's open, the spike from last Tuesday -
+ * through the same ingestion path the live feed uses, so a latency
+ * regression can be reproduced at the desk instead of waiting for the
+ * market to do it again.
+ *
+ * Design points:
+ *
+ * 1. The capture is mmap'd, never read(). Packet bytes are decoded
+ *    straight out of the mapping - zero copies, zero per-packet heap
+ *    allocations - so replay overhead doesn't distort what we're
+ *    trying to measure. madvise(SEQUENTIAL) tells the kernel to
+ *    read-ahead aggressively and drop pages behind the cursor.
+ *
+ * 2. Packet offsets are indexed once, not discovered per replay. The
+ *    index (offset, caplen, timestamp) is built in a single forward
+ *    scan at open(), or loaded from a sidecar ".idx" file so a 100GB
+ *    capture opens in milliseconds on the second run. The sidecar
+ *    records the capture's size+mtime and is ignored when stale.
+ *
+ * 3. Pacing is TSC-based. Original inter-packet gaps are reproduced by
+ *    spinning on RDTSC (no nanosleep - the scheduler's ~50us wakeup
+ *    granularity would flatten every burst in the capture). FIREHOSE
+ *    mode skips pacing entirely and measures the ceiling.
+ *
+ * Formats: classic pcap (both endiannesses, usec and nsec variants)
+ * and pcapng (native endianness, Enhanced Packet Blocks, if_tsresol
+ * honored). That covers tcpdump, wireshark and our capture boxes.
+ */
+
+namespace hft {
+
+// ============================================================================
+// Replay pacing mode
+// ============================================================================
+enum class ReplayMode {
+    PACED,     // Reproduce original inter-packet timing (TSC spin)
+    FIREHOSE   // Inject as fast as the queue accepts
+};
+
+// ============================================================================
+// One indexed packet: points INTO the mapping, owns nothing
+// ============================================================================
+struct PacketRef {
+    uint64_t offset;        // Byte offset of packet data in the file
+    uint32_t caplen;        // Captured bytes available at that offset
+    uint32_t orig_len;      // Original wire length
+    uint64_t timestamp_ns;  // Capture timestamp (epoch ns)
+};
+
+// ============================================================================
+// PcapReplayer
+// ============================================================================
+class PcapReplayer {
+public:
+    PcapReplayer()
+        : fd_(-1), map_(nullptr), map_size_(0), tsc_hz_(0.0) {}
+
+    ~PcapReplayer() { close(); }
+
+    PcapReplayer(const PcapReplayer&) = delete;
+    PcapReplayer& operator=(const PcapReplayer&) = delete;
+
+    // ========================================================================
+    // Open a capture and build (or load) the packet index
+    //
+    // With use_sidecar_index the engine looks for "<path>.idx" first
+    // and writes one after a successful scan, so only the first open
+    // of a capture pays the full-file pass.
+    // ========================================================================
+    bool open(const std::string& path, bool use_sidecar_index = true) {
+        close();
+
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            std::fprintf(stderr, "PcapReplayer: cannot open %s\n",
+                         path.c_str());
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || st.st_size < 24) {
+            std::fprintf(stderr, "PcapReplayer: %s too small for a capture\n",
+                         path.c_str());
+            close();
+            return false;
+        }
+        map_size_ = static_cast<size_t>(st.st_size);
+
+        map_ = static_cast<const uint8_t*>(
+            mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0));
+        if (map_ == MAP_FAILED) {
+            std::fprintf(stderr, "PcapReplayer: mmap failed for %s\n",
+                         path.c_str());
+            map_ = nullptr;
+            close();
+            return false;
+        }
+
+        // Replay walks the file front to back exactly once per pass -
+        // let the kernel read ahead and reclaim behind us
+        madvise(const_cast<uint8_t*>(map_), map_size_, MADV_SEQUENTIAL);
+
+        path_ = path;
+
+        if (use_sidecar_index &&
+            load_sidecar_index(path + ".idx", st)) {
+            return true;  // 100GB capture, millisecond open
+        }
+
+        const bool ok = build_index();
+        if (ok && use_sidecar_index) {
+            save_sidecar_index(path + ".idx", st);  // Best effort
+        }
+        return ok;
+    }
+
+    void close() {
+        if (map_) {
+            munmap(const_cast<uint8_t*>(map_), map_size_);
+            map_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        map_size_ = 0;
+        index_.clear();
+        path_.clear();
+    }
+
+    // ========================================================================
+    // Zero-copy packet access
+    // ========================================================================
+    size_t packet_count() const { return index_.size(); }
+
+    const PacketRef& packet(size_t i) const { return index_[i]; }
+
+    /** Pointer directly into the mapping - valid until close() */
+    const uint8_t* packet_data(size_t i) const {
+        return map_ + index_[i].offset;
+    }
+
+    /** Capture duration first-to-last packet, in ns */
+    uint64_t duration_ns() const {
+        if (index_.size() < 2) return 0;
+        return index_.back().timestamp_ns - index_.front().timestamp_ns;
+    }
+
+    // ========================================================================
+    // Replay the capture into a KernelBypassNIC
+    //
+    // Each frame is decoded by ExchangeProtocol straight out of the
+    // mapping and the resulting ticks go through inject_batch() - the
+    // exact producer path the live poll loop uses.
+    //
+    // PACED reproduces the capture's inter-packet gaps (divided by
+    // `speed`, so speed=2.0 replays at double rate) by spinning on the
+    // TSC. FIREHOSE decodes into 64-tick batches and injects them as
+    // fast as the consumer drains - the throughput ceiling.
+    //
+    // @return Number of ticks successfully injected. Frames the
+    //         protocol rejects (wrong port, runt, non-market traffic in
+    //         the capture) are skipped and not counted.
+    // ========================================================================
+    template<typename ExchangeProtocol>
+    size_t replay(KernelBypassNIC& nic,
+                  ReplayMode mode = ReplayMode::PACED,
+                  double speed = 1.0) {
+        if (index_.empty() || !nic.is_running()) {
+            return 0;
+        }
+
+        if (mode == ReplayMode::PACED) {
+            return replay_paced<ExchangeProtocol>(nic, speed);
+        }
+        return replay_firehose<ExchangeProtocol>(nic);
+    }
+
+private:
+    // ========================================================================
+    // Format parsing
+    // ========================================================================
+
+    static constexpr uint32_t PCAP_MAGIC_US = 0xa1b2c3d4;   // usec timestamps
+    static constexpr uint32_t PCAP_MAGIC_US_SW = 0xd4c3b2a1;
+    static constexpr uint32_t PCAP_MAGIC_NS = 0xa1b23c4d;   // nsec timestamps
+    static constexpr uint32_t PCAP_MAGIC_NS_SW = 0x4d3cb2a1;
+    static constexpr uint32_t PCAPNG_SHB = 0x0a0d0d0a;
+    static constexpr uint32_t PCAPNG_IDB = 0x00000001;
+    static constexpr uint32_t PCAPNG_EPB = 0x00000006;
+    static constexpr uint32_t PCAPNG_BYTE_ORDER = 0x1a2b3c4d;
+
+    static uint32_t bswap32(uint32_t v) {
+        return __builtin_bswap32(v);
+    }
+
+    uint32_t read_u32(uint64_t off, bool swap) const {
+        uint32_t v;
+        std::memcpy(&v, map_ + off, sizeof(v));
+        return swap ? bswap32(v) : v;
+    }
+
+    bool build_index() {
+        index_.clear();
+        // ~16B/pkt header overhead in classic pcap; a rough pre-reserve
+        // avoids most of the vector's doubling copies on big captures
+        index_.reserve(map_size_ / 128 + 16);
+
+        uint32_t magic;
+        std::memcpy(&magic, map_, sizeof(magic));
+
+        switch (magic) {
+        case PCAP_MAGIC_US:    return index_pcap(false, 1000);
+        case PCAP_MAGIC_US_SW: return index_pcap(true, 1000);
+        case PCAP_MAGIC_NS:    return index_pcap(false, 1);
+        case PCAP_MAGIC_NS_SW: return index_pcap(true, 1);
+        case PCAPNG_SHB:       return index_pcapng();
+        default:
+            std::fprintf(stderr,
+                         "PcapReplayer: %s is not pcap or pcapng "
+                         "(magic 0x%08x)\n", path_.c_str(), magic);
+            return false;
+        }
+    }
+
+    /**
+     * Classic pcap: 24-byte global header, then per-record
+     * { ts_sec, ts_frac, incl_len, orig_len } + data.
+     * frac_to_ns is 1000 for usec captures, 1 for nsec captures.
+     */
+    bool index_pcap(bool swap, uint64_t frac_to_ns) {
+        uint64_t off = 24;
+        while (off + 16 <= map_size_) {
+            const uint64_t ts_sec = read_u32(off, swap);
+            const uint64_t ts_frac = read_u32(off + 4, swap);
+            const uint32_t caplen = read_u32(off + 8, swap);
+            const uint32_t origlen = read_u32(off + 12, swap);
+            off += 16;
+
+            if (caplen > map_size_ - off) {
+                std::fprintf(stderr,
+                             "PcapReplayer: truncated record at offset "
+                             "%llu - indexing what we have\n",
+                             (unsigned long long)off);
+                break;
+            }
+
+            index_.push_back(PacketRef{
+                off, caplen, origlen,
+                ts_sec * 1000000000ULL + ts_frac * frac_to_ns});
+            off += caplen;
+        }
+        return !index_.empty();
+    }
+
+    /**
+     * pcapng: a sequence of { type, total_len, body, total_len }
+     * blocks. We index Enhanced Packet Blocks and read if_tsresol from
+     * Interface Description Blocks (default 10^-6). Swapped-endian
+     * pcapng is rejected - none of our capture boxes produce it.
+     */
+    bool index_pcapng() {
+        // Timestamp resolution per interface (pcapng allows several);
+        // value is ns-per-tick
+        std::vector<uint64_t> if_ns_per_tick;
+
+        {
+            const uint32_t bom = read_u32(8, false);
+            if (bom != PCAPNG_BYTE_ORDER) {
+                std::fprintf(stderr,
+                             "PcapReplayer: swapped-endian pcapng is not "
+                             "supported\n");
+                return false;
+            }
+        }
+
+        uint64_t off = 0;
+        while (off + 12 <= map_size_) {
+            const uint32_t type = read_u32(off, false);
+            const uint32_t total_len = read_u32(off + 4, false);
+            if (total_len < 12 || (total_len & 3) ||
+                total_len > map_size_ - off) {
+                break;  // Corrupt or truncated tail
+            }
+
+            if (type == PCAPNG_IDB) {
+                if_ns_per_tick.push_back(parse_if_tsresol(off, total_len));
+            } else if (type == PCAPNG_EPB && total_len >= 32) {
+                const uint32_t if_id = read_u32(off + 8, false);
+                const uint64_t ts = (uint64_t(read_u32(off + 12, false)) << 32)
+                                  | read_u32(off + 16, false);
+                const uint32_t caplen = read_u32(off + 20, false);
+                const uint32_t origlen = read_u32(off + 24, false);
+
+                const uint64_t ns_per_tick =
+                    (if_id < if_ns_per_tick.size())
+                        ? if_ns_per_tick[if_id] : 1000;
+
+                if (caplen <= total_len - 32) {
+                    index_.push_back(PacketRef{
+                        off + 28, caplen, origlen, ts * ns_per_tick});
+                }
+            }
+            off += total_len;
+        }
+        return !index_.empty();
+    }
+
+    /** if_tsresol (option 9) of an IDB, as ns-per-tick; default usec */
+    uint64_t parse_if_tsresol(uint64_t block_off, uint32_t total_len) const {
+        // IDB body: linktype u16, reserved u16, snaplen u32, options
+        uint64_t opt = block_off + 16;
+        const uint64_t end = block_off + total_len - 4;
+        while (opt + 4 <= end) {
+            uint16_t code, len;
+            std::memcpy(&code, map_ + opt, 2);
+            std::memcpy(&len, map_ + opt + 2, 2);
+            if (code == 0) break;  // opt_endofopt
+            if (code == 9 && len >= 1) {
+                const uint8_t r = map_[opt + 4];
+                if (r & 0x80) {
+                    return 0;  // Power-of-2 resolution: nobody uses it
+                }
+                uint64_t ticks_per_sec = 1;
+                for (uint8_t i = 0; i < r && i < 9; ++i) {
+                    ticks_per_sec *= 10;
+                }
+                return 1000000000ULL / ticks_per_sec;
+            }
+            opt += 4 + ((len + 3u) & ~3u);  // Options are 32-bit padded
+        }
+        return 1000;  // Default 10^-6
+    }
+
+    // ========================================================================
+    // Sidecar index file: "<capture>.idx"
+    //
+    // Header records the capture's size and mtime so an index left
+    // behind by an older version of the file is detected and rebuilt.
+    // ========================================================================
+
+    struct SidecarHeader {
+        uint64_t magic;     // IDX_MAGIC
+        uint64_t src_size;  // Capture size when indexed
+        int64_t src_mtime;  // Capture mtime when indexed
+        uint64_t count;     // PacketRef entries that follow
+    };
+
+    static constexpr uint64_t IDX_MAGIC = 0x5852504143505845ULL;  // "EXPCAPRX"
+
+    bool load_sidecar_index(const std::string& idx_path,
+                            const struct stat& src) {
+        FILE* f = std::fopen(idx_path.c_str(), "rb");
+        if (!f) return false;
+
+        SidecarHeader h;
+        bool ok = std::fread(&h, sizeof(h), 1, f) == 1 &&
+                  h.magic == IDX_MAGIC &&
+                  h.src_size == static_cast<uint64_t>(src.st_size) &&
+                  h.src_mtime == static_cast<int64_t>(src.st_mtime);
+        if (ok) {
+            index_.resize(h.count);
+            ok = std::fread(index_.data(), sizeof(PacketRef),
+                            h.count, f) == h.count;
+            if (!ok) index_.clear();
+        }
+        std::fclose(f);
+        return ok && !index_.empty();
+    }
+
+    void save_sidecar_index(const std::string& idx_path,
+                            const struct stat& src) const {
+        FILE* f = std::fopen(idx_path.c_str(), "wb");
+        if (!f) return;  // Read-only capture dir - fine, we just rescan
+
+        SidecarHeader h{IDX_MAGIC,
+                        static_cast<uint64_t>(src.st_size),
+                        static_cast<int64_t>(src.st_mtime),
+                        index_.size()};
+        if (std::fwrite(&h, sizeof(h), 1, f) != 1 ||
+            std::fwrite(index_.data(), sizeof(PacketRef),
+                        index_.size(), f) != index_.size()) {
+            std::fclose(f);
+            std::remove(idx_path.c_str());  // Don't leave a torn index
+            return;
+        }
+        std::fclose(f);
+    }
+
+    // ========================================================================
+    // Replay inner loops
+    // ========================================================================
+
+    /**
+     * Original timing, reproduced with a TSC spin per packet. The tick
+     * is decoded FIRST, then we spin until the scheduled release time -
+     * decode cost hides inside the gap instead of adding to it.
+     */
+    template<typename ExchangeProtocol>
+    size_t replay_paced(KernelBypassNIC& nic, double speed) {
+        calibrate_tsc();
+        const double ticks_per_ns = tsc_hz_ / 1e9;
+
+        const uint64_t t0_ns = index_.front().timestamp_ns;
+        const uint64_t tsc0 = ull_nic::get_timestamp();
+
+        size_t injected = 0;
+        MarketTick tick;
+        for (const PacketRef& ref : index_) {
+            if (!ExchangeProtocol::decode(map_ + ref.offset, ref.caplen,
+                                          tick)) {
+                continue;  // Non-market traffic in the capture
+            }
+            tick.timestamp = ref.timestamp_ns;
+
+            const uint64_t due = tsc0 + static_cast<uint64_t>(
+                (ref.timestamp_ns - t0_ns) / speed * ticks_per_ns);
+            while (ull_nic::get_timestamp() < due) {
+                // Spin - nanosleep's wakeup jitter would flatten bursts
+            }
+
+            injected += nic.inject_batch(&tick, 1);
+        }
+        return injected;
+    }
+
+    /**
+     * No pacing: decode into 64-tick batches and shove them through
+     * inject_batch() as fast as the consumer drains the ring.
+     */
+    template<typename ExchangeProtocol>
+    size_t replay_firehose(KernelBypassNIC& nic) {
+        constexpr size_t BATCH = 64;
+        MarketTick batch[BATCH];
+        size_t n = 0, injected = 0;
+
+        for (const PacketRef& ref : index_) {
+            if (!ExchangeProtocol::decode(map_ + ref.offset, ref.caplen,
+                                          batch[n])) {
+                continue;
+            }
+            batch[n].timestamp = ref.timestamp_ns;
+
+            if (++n == BATCH) {
+                injected += inject_all(nic, batch, n);
+                n = 0;
+            }
+        }
+        if (n > 0) {
+            injected += inject_all(nic, batch, n);
+        }
+        return injected;
+    }
+
+    /** inject_batch until the whole batch is in (ring may be full) */
+    static size_t inject_all(KernelBypassNIC& nic,
+                             const MarketTick* ticks, size_t count) {
+        size_t done = 0;
+        while (done < count && nic.is_running()) {
+            done += nic.inject_batch(ticks + done, count - done);
+        }
+        return done;
+    }
+
+    /** Quick TSC frequency estimate (10ms against CLOCK_MONOTONIC) */
+    void calibrate_tsc() {
+        if (tsc_hz_ > 0.0) return;
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        const uint64_t c0 = ull_nic::get_timestamp();
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+        } while ((t1.tv_sec - t0.tv_sec) * 1000000000LL +
+                 (t1.tv_nsec - t0.tv_nsec) < 10000000LL);
+        const uint64_t c1 = ull_nic::get_timestamp();
+
+        const double ns = (t1.tv_sec - t0.tv_sec) * 1e9 +
+                          (t1.tv_nsec - t0.tv_nsec);
+        tsc_hz_ = (c1 - c0) / ns * 1e9;
+    }
+
+    int fd_;
+    const uint8_t* map_;
+    size_t map_size_;
+    std::string path_;
+    std::vector<PacketRef> index_;
+    double tsc_hz_;
+};
+
+} // namespace hft
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "common_types.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @file ring_diagnostics.hpp
+ * @brief Descriptor-ring snapshot and tracepoint surface shared by all drivers
+ *
+ * When a queue stalls in production, the only alternative to this file is
+ * attaching a debugger to a live trading process. The drivers already hold
+ * everything a post-mortem needs - software cursors, hardware head/tail
+ * registers, DD-bit state - they just never exposed it. Two facilities fix
+ * that:
+ *
+ * 1. RingSnapshot: a control thread calls driver.snapshot() and gets a
+ *    consistent sample of cursors, registers, and derived occupancy. The
+ *    sample is taken WITHOUT locks and WITHOUT touching descriptor memory:
+ *    the poller keeps running at full speed, unaware it is being observed.
+ *    Consistency comes from a seqlock-style resample (read cursors, read
+ *    registers, re-read cursors; retry if the poller moved) - the reader
+ *    pays for stability, the writer pays nothing.
+ *
+ * 2. RingTracer: a fixed-size in-memory ring of TSC-stamped ring events
+ *    (packet consumed, doorbell rung, reclaim pass, ring full). Gated at
+ *    COMPILE TIME by ULL_NIC_RING_TRACE: when disabled (the default) every
+ *    record() call is an `if constexpr (false)` - no code, no storage, no
+ *    branch on the hot path. When enabled, a record is one TSC read plus
+ *    four plain stores to a thread-local-hot line (~10ns), cheap enough to
+ *    leave on in a canary deployment. After a stall, dump() yields the last
+ *    N ring transitions in order - what the ring was doing in the
+ *    microseconds BEFORE the symptom, which a snapshot alone cannot show.
+ *
+ * Build with tracing: -DULL_NIC_RING_TRACE=1
+ *
+ * @author Krishna Bajpai (krishna@krishnabajpai.me)
+ * @date December 2025
+ */
+
+// Compile-time gate: 0 (default) compiles every tracepoint away entirely
+#ifndef ULL_NIC_RING_TRACE
+#define ULL_NIC_RING_TRACE 0
+#endif
+
+namespace ull_nic {
+
+constexpr bool kRingTraceEnabled = (ULL_NIC_RING_TRACE != 0);
+
+// ============================================================================
+// Ring Snapshot
+// ============================================================================
+
+/**
+ * @brief Point-in-time sample of one RX/TX ring pair
+ *
+ * Filled by each driver's snapshot(). Fields a given driver does not
+ * track are left zero (e.g. CustomNICDriver keeps no packet counters;
+ * BroadcomNetXtreme has no separate doorbell tail).
+ *
+ * Reading a stall from a snapshot:
+ * - hw_rx_head advancing, sw_rx_head stuck  -> poller dead / descheduled
+ * - both stuck, link up                     -> steering or hardware drop
+ * - tx_in_flight pinned at ring size        -> completions not returning
+ * - hw_tx_tail != sw_tx_tail                -> doorbell write lost
+ */
+struct RingSnapshot {
+    uint64_t tsc;                // get_timestamp() at sample time
+
+    // Software cursors (what the driver believes)
+    uint32_t sw_rx_head;         // Next RX descriptor the poller will read
+    uint32_t sw_tx_head;         // Reclaim cursor / cached hardware TX head
+    uint32_t sw_tx_tail;         // Next free TX descriptor
+    uint32_t sw_tx_doorbell;     // Last TX tail exposed to hardware (0 if
+                                 //   the driver has no doorbell coalescing)
+
+    // Hardware registers (what the NIC believes - uncached MMIO reads)
+    uint32_t hw_rx_head;
+    uint32_t hw_rx_tail;
+    uint32_t hw_tx_head;
+    uint32_t hw_tx_tail;
+
+    // Derived occupancy (masked ring arithmetic on the values above)
+    uint32_t rx_backlog;         // Completed descriptors not yet consumed
+    uint32_t tx_in_flight;       // Posted descriptors not yet reclaimed
+
+    // Lifetime counters (0 where the driver keeps none)
+    uint64_t packets_received;
+    uint64_t packets_sent;
+};
+
+// ============================================================================
+// Ring Tracepoints
+// ============================================================================
+
+/** @brief Ring transition kinds recorded by the tracer */
+enum class RingEvent : uint8_t {
+    RX_PACKET    = 1,  // One packet consumed     (index = slot, aux = length)
+    RX_BURST     = 2,  // Burst drained           (index = first slot, aux = count)
+    RX_DOORBELL  = 3,  // RX tail written         (index = new tail)
+    TX_POST      = 4,  // Descriptor staged       (index = slot, aux = length)
+    TX_DOORBELL  = 5,  // TX tail written         (index = new tail, aux = count)
+    TX_RECLAIM   = 6,  // Completion pass         (index = new head, aux = freed)
+    TX_RING_FULL = 7,  // Send refused: no slots  (index = tail at refusal)
+};
+
+/**
+ * @brief One trace record - 16 bytes, four per cache line
+ */
+struct RingTraceRecord {
+    uint64_t tsc;        // get_timestamp() when the event was recorded
+    uint32_t aux;        // Event-specific payload (length, count, freed)
+    uint16_t index;      // Ring slot the event concerns
+    RingEvent event;
+    uint8_t reserved;
+};
+static_assert(sizeof(RingTraceRecord) == 16, "trace record is 16 bytes");
+
+/**
+ * @brief Fixed-size in-memory event ring, compile-time removable
+ *
+ * Single-writer (the polling thread), wrapping overwrite - the buffer
+ * always holds the LAST Capacity transitions, which is exactly what a
+ * stall post-mortem wants. A control thread may dump() concurrently;
+ * like the driver stats structs, records near the write cursor may be
+ * mid-update, so dump() skips the slot currently being written.
+ *
+ * With Enabled = false the class holds no storage (empty-base-sized
+ * state) and record() compiles to nothing via `if constexpr` - the
+ * tracepoints in the drivers cost literally zero instructions.
+ */
+template<bool Enabled, size_t Capacity = 256>
+class RingTracer {
+    static_assert((Capacity & (Capacity - 1)) == 0,
+                  "trace capacity must be a power of 2");
+
+    struct Storage {
+        RingTraceRecord records[Capacity];
+        uint64_t seq = 0;  // Total records ever written (wraps the ring)
+    };
+    struct NoStorage {};
+    using State = typename std::conditional<Enabled, Storage, NoStorage>::type;
+
+public:
+    static constexpr bool enabled = Enabled;
+    static constexpr size_t capacity = Capacity;
+
+    /**
+     * @brief Record one ring transition (hot path - plain stores only)
+     */
+    inline void record(RingEvent event, uint16_t index, uint32_t aux = 0) {
+        if constexpr (Enabled) {
+            RingTraceRecord& r = state_.records[state_.seq & (Capacity - 1)];
+            r.tsc = get_timestamp();
+            r.aux = aux;
+            r.index = index;
+            r.event = event;
+            state_.seq++;  // Publish after the fields (single writer)
+        } else {
+            (void)event; (void)index; (void)aux;
+        }
+    }
+
+    /** @brief Total records ever written (wrapped records included) */
+    inline uint64_t recorded() const {
+        if constexpr (Enabled) {
+            return state_.seq;
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Copy out the most recent records, oldest first
+     *
+     * @param out Caller array of at least `max` records
+     * @param max Maximum records to copy (clamped to what exists)
+     * @return Number of records written to `out` (0 when tracing is
+     *         compiled out)
+     */
+    size_t dump(RingTraceRecord* out, size_t max) const {
+        if constexpr (Enabled) {
+            uint64_t seq = state_.seq;
+            size_t avail = (seq < Capacity) ? static_cast<size_t>(seq)
+                                            : Capacity - 1;  // Skip live slot
+            size_t n = (max < avail) ? max : avail;
+            for (size_t i = 0; i < n; i++) {
+                out[i] = state_.records[(seq - n + i) & (Capacity - 1)];
+            }
+            return n;
+        } else {
+            (void)out; (void)max;
+            return 0;
+        }
+    }
+
+private:
+    State state_;
+};
+
+} // namespace ull_nic
@@ -0,0 +1,296 @@
+#pragma once
+
+#include "common_types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file sharded_stats.hpp
+ * @brief Cache-line-sharded statistics counters for multi-queue hot paths
+ *
+ * The problem with one shared PacketStats: the moment two polling
+ * threads increment counters in the same struct, every increment
+ * invalidates the other core's cache line. The counters are logically
+ * independent but physically adjacent - textbook false sharing, and it
+ * shows up as HITM events in `perf c2c` and a measurable hit to
+ * per-queue throughput.
+ *
+ * The fix is structural, not atomic-ordering cleverness:
+ *
+ * 1. One counter block PER QUEUE (or per thread), each alignas(64) so
+ *    no two writers ever touch the same line.
+ *
+ * 2. Hot-path updates are plain stores. Each shard has exactly one
+ *    writer, so `c = c + 1` with relaxed ordering compiles to a single
+ *    `add` instruction - no lock prefix, no fence, no RMW bus traffic.
+ *
+ * 3. Aggregation happens on the READER. Whoever wants totals (stats
+ *    thread, monitoring endpoint) walks the shards and sums them.
+ *    That thread eats the cache misses; the polling cores never see it.
+ *
+ * 4. Rates (pps/Gbps) are derived reader-side from two aggregate
+ *    snapshots and a wall-clock delta - zero work on the hot path.
+ *
+ * Counter values are read with relaxed atomics, so a reader may see a
+ * total that is a few increments stale across shards. For statistics
+ * that is exactly good enough; what it never sees is a torn value.
+ */
+
+namespace ull_nic {
+
+// ============================================================================
+// Per-Thread Shard Assignment
+// ============================================================================
+
+/**
+ * @brief Stable shard index for the calling thread
+ *
+ * Threads register lazily: the first call from a new thread claims the
+ * next index (wrapping at max_shards - a wrap means two threads share
+ * a shard, which is merely slower, never wrong, because the updates
+ * are still full atomic cells).
+ *
+ * Use this where the shard isn't implied by a queue id - e.g. the
+ * inference bridge, which is called from whichever strategy thread.
+ */
+inline size_t this_thread_shard(size_t max_shards) {
+    static std::atomic<size_t> next_id{0};
+    thread_local size_t id =
+        next_id.fetch_add(1, std::memory_order_relaxed);
+    return id % max_shards;
+}
+
+// ============================================================================
+// Generic Sharded Counter Block
+// ============================================================================
+
+/**
+ * @class ShardedCounters
+ * @brief NumCounters independent uint64 counters, sharded across
+ *        MaxShards cache-line-aligned blocks
+ *
+ * The cells are generic - whether a cell is a running sum or a running
+ * max is the writer's and reader's convention (add()/sum() vs
+ * record_max()/max()). Keep NumCounters <= 8 if you want one shard
+ * per cache line; larger blocks span lines but still never share one
+ * with another shard.
+ */
+template<size_t NumCounters, size_t MaxShards = 16>
+class ShardedCounters {
+public:
+    static constexpr size_t NUM_COUNTERS = NumCounters;
+    static constexpr size_t MAX_SHARDS = MaxShards;
+
+    ShardedCounters() { reset(); }
+
+    // ------------------------------------------------------------------------
+    // Writer side (hot path - one writer per shard)
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Add to a counter: plain load + store, compiles to one add
+     *
+     * NOT an atomic RMW on purpose - the shard has a single writer, so
+     * load-modify-store cannot lose updates, and skipping the lock
+     * prefix keeps this off the coherence fast path entirely.
+     */
+    inline void add(size_t shard, size_t idx, uint64_t delta) {
+        auto& c = shards_[shard].cell[idx];
+        c.store(c.load(std::memory_order_relaxed) + delta,
+                std::memory_order_relaxed);
+    }
+
+    /** @brief add(shard, idx, 1) */
+    inline void inc(size_t shard, size_t idx) { add(shard, idx, 1); }
+
+    /**
+     * @brief Keep the running maximum in a cell (single writer, so a
+     *        compare + plain store suffices - no CAS loop)
+     */
+    inline void record_max(size_t shard, size_t idx, uint64_t value) {
+        auto& c = shards_[shard].cell[idx];
+        if (value > c.load(std::memory_order_relaxed)) {
+            c.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reader side (aggregation - run this OFF the polling cores)
+    // ------------------------------------------------------------------------
+
+    /** @brief Sum one counter across all shards */
+    uint64_t sum(size_t idx) const {
+        uint64_t total = 0;
+        for (size_t s = 0; s < MaxShards; s++) {
+            total += shards_[s].cell[idx].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /** @brief Max of one counter across all shards */
+    uint64_t max(size_t idx) const {
+        uint64_t m = 0;
+        for (size_t s = 0; s < MaxShards; s++) {
+            const uint64_t v =
+                shards_[s].cell[idx].load(std::memory_order_relaxed);
+            if (v > m) m = v;
+        }
+        return m;
+    }
+
+    /** @brief Sum all counters into out[NumCounters] in one pass */
+    void snapshot(uint64_t* out) const {
+        for (size_t i = 0; i < NumCounters; i++) out[i] = 0;
+        for (size_t s = 0; s < MaxShards; s++) {
+            for (size_t i = 0; i < NumCounters; i++) {
+                out[i] +=
+                    shards_[s].cell[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** @brief Zero every cell (quiesce writers first if exactness matters) */
+    void reset() {
+        for (size_t s = 0; s < MaxShards; s++) {
+            for (size_t i = 0; i < NumCounters; i++) {
+                shards_[s].cell[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    /// One writer's counter block - alignas keeps neighbouring shards
+    /// on disjoint cache lines, which is the entire point
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> cell[NumCounters];
+    };
+
+    Shard shards_[MaxShards];
+};
+
+// ============================================================================
+// Sharded Packet Statistics (PacketStats, multi-queue edition)
+// ============================================================================
+
+/**
+ * @class ShardedPacketStats
+ * @brief Drop-in multi-queue replacement for a shared PacketStats
+ *
+ * Each RX/TX queue updates its own shard (use the queue id); readers
+ * call aggregate() and get the familiar PacketStats totals back.
+ */
+class ShardedPacketStats {
+public:
+    enum Field : size_t {
+        RX_PACKETS = 0,
+        TX_PACKETS,
+        RX_BYTES,
+        TX_BYTES,
+        RX_ERRORS,
+        TX_ERRORS,
+        RX_DROPPED,
+        TX_DROPPED,
+        FIELD_COUNT
+    };
+
+    static constexpr size_t MAX_SHARDS = 16;
+
+    // Hot path: queue `shard` counts its own traffic, nobody else's
+    inline void add(size_t shard, Field f, uint64_t delta) {
+        counters_.add(shard, f, delta);
+    }
+
+    inline void inc(size_t shard, Field f) { counters_.inc(shard, f); }
+
+    /// Common case in one call: a packet of `bytes` received on `shard`
+    inline void count_rx(size_t shard, uint64_t bytes, uint64_t packets = 1) {
+        counters_.add(shard, RX_PACKETS, packets);
+        counters_.add(shard, RX_BYTES, bytes);
+    }
+
+    inline void count_tx(size_t shard, uint64_t bytes, uint64_t packets = 1) {
+        counters_.add(shard, TX_PACKETS, packets);
+        counters_.add(shard, TX_BYTES, bytes);
+    }
+
+    /** @brief Totals across all queues, as the classic PacketStats */
+    PacketStats aggregate() const {
+        uint64_t v[FIELD_COUNT];
+        counters_.snapshot(v);
+
+        PacketStats out;
+        out.packets_received = v[RX_PACKETS];
+        out.packets_transmitted = v[TX_PACKETS];
+        out.bytes_received = v[RX_BYTES];
+        out.bytes_transmitted = v[TX_BYTES];
+        out.rx_errors = v[RX_ERRORS];
+        out.tx_errors = v[TX_ERRORS];
+        out.rx_dropped = v[RX_DROPPED];
+        out.tx_dropped = v[TX_DROPPED];
+        return out;
+    }
+
+    void reset() { counters_.reset(); }
+
+private:
+    ShardedCounters<FIELD_COUNT, MAX_SHARDS> counters_;
+};
+
+// ============================================================================
+// Reader-Side Rate Derivation
+// ============================================================================
+
+/**
+ * @class PacketRateSampler
+ * @brief pps/Gbps over the window between two sample() calls
+ *
+ * Owned and called by the stats/monitoring thread - the polling cores
+ * contribute nothing but their plain-store counter updates. Wire-rate
+ * Gbps includes the 24B per-packet overhead (preamble + IFG + FCS) so
+ * the number is comparable to link capacity.
+ */
+class PacketRateSampler {
+public:
+    struct Rates {
+        double rx_pps;
+        double tx_pps;
+        double rx_gbps;   ///< Wire rate including framing overhead
+        double tx_gbps;
+    };
+
+    static constexpr uint64_t WIRE_OVERHEAD_BYTES = 24;
+
+    /** @brief Rates since the previous call (first call returns zeros) */
+    Rates sample(const ShardedPacketStats& stats) {
+        const PacketStats cur = stats.aggregate();
+        const uint64_t now_ns = get_wall_time_ns();
+
+        Rates r{0.0, 0.0, 0.0, 0.0};
+        if (have_prev_ && now_ns > prev_ns_) {
+            const double secs = (now_ns - prev_ns_) * 1e-9;
+            const uint64_t drx = cur.packets_received - prev_.packets_received;
+            const uint64_t dtx =
+                cur.packets_transmitted - prev_.packets_transmitted;
+
+            r.rx_pps = drx / secs;
+            r.tx_pps = dtx / secs;
+            r.rx_gbps = ((cur.bytes_received - prev_.bytes_received) +
+                         drx * WIRE_OVERHEAD_BYTES) * 8.0 / secs / 1e9;
+            r.tx_gbps = ((cur.bytes_transmitted - prev_.bytes_transmitted) +
+                         dtx * WIRE_OVERHEAD_BYTES) * 8.0 / secs / 1e9;
+        }
+
+        prev_ = cur;
+        prev_ns_ = now_ns;
+        have_prev_ = true;
+        return r;
+    }
+
+private:
+    PacketStats prev_;
+    uint64_t prev_ns_ = 0;
+    bool have_prev_ = false;
+};
+
+} // namespace ull_nic
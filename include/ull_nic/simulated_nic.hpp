@@ -0,0 +1,598 @@
+#pragma once
+
+#include "custom_nic_driver.hpp"
+#include "arm64_nic_driver.hpp"
+#include "broadcom_netxtreme.hpp"
+#include "dma_arena.hpp"
+#include "common_types.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @file simulated_nic.hpp
+ * @brief Software NIC device model - the other side of the BAR0 mapping
+ *
+ * Every driver in this repo talks to hardware through exactly two
+ * channels: MMIO registers in a mapped BAR0, and DMA reads/writes of
+ * descriptor rings and packet buffers. Nothing else. That narrow
+ * contract is what makes a full software device possible: back BAR0
+ * with a plain file, hand the driver its path, and implement the
+ * device side of the register protocol over the same mapping.
+ *
+ * SimulatedNIC does that for all three register layouts:
+ *
+ *   SimulatedNIC<IntelX710SimModel>   <- CustomNICDriver<IntelX710Regs>
+ *   SimulatedNIC<ARM64SimModel>       <- ull_nic::ARM64NICDriver
+ *   SimulatedNIC<BroadcomSimModel>    <- ull_nic::BroadcomNetXtreme
+ *
+ * The drivers run UNCHANGED - same initialize(), same descriptor
+ * formats, same doorbells. The simulator honours the ordering rules
+ * real silicon honours, because the drivers' correctness depends on
+ * them:
+ *
+ * - RX: payload and descriptor fields are written BEFORE the DD bit
+ *   (release fence between), and the head register advances only after
+ *   DD is visible - a poller can never see DD set over a stale buffer.
+ * - TX: payload is read out before DD is set; the TX head register
+ *   moves only after the whole chain is completed.
+ * - An RX slot is free when its DD bit is clear - the same ownership
+ *   handoff loopback_pump() implements (drivers clear DD on consume).
+ * - Reset: drivers that assert the reset bit at initialize() spin
+ *   until the device clears it; the simulator clears it in pump().
+ *
+ * What this is for: exercising the REAL driver ring logic - wraparound,
+ * full-ring backpressure, completion ordering, scatter-gather chains -
+ * on machines with no passthrough hardware. It extends the loopback
+ * mode of CustomNICDriver (which only echoes TX to RX within one
+ * driver) to arbitrary traffic, injected RX, and the two sysfs-path
+ * drivers that have no loopback mode of their own.
+ *
+ * What it is NOT: a timing model. Register reads are DRAM loads here;
+ * never benchmark MMIO costs against it.
+ *
+ * Driving it: call pump() from the test thread for deterministic
+ * single-threaded runs, or start()/stop() a background service thread
+ * when the driver needs the device responding mid-call (the ARM64 and
+ * Broadcom initialize() paths block on the reset handshake).
+ *
+ * DMA addressing: ARM64NICDriver and BroadcomNetXtreme use identity
+ * bus addresses (virtual == bus), which the simulator resolves
+ * natively since it shares the process. CustomNICDriver publishes REAL
+ * physical addresses from its DmaArena pagemap walk, so the simulator
+ * keeps an IOMMU-style window table - map_dma_arena() registers each arena
+ * page's bus->host translation, and anything unmapped falls back to
+ * identity.
+ *
+ * @author Krishna Bajpai (krishna@krishnabajpai.me)
+ * @date December 2025
+ */
+
+namespace hft {
+namespace hardware {
+
+// ============================================================================
+// Device Models - per-driver register offsets and descriptor operations
+// ============================================================================
+
+/**
+ * @brief Device model for CustomNICDriver<IntelX710Regs> (i40e layout)
+ */
+struct IntelX710SimModel {
+    using RxDesc = RXDescriptor;
+    using TxDesc = TXDescriptor;
+
+    static constexpr uint32_t RX_SIZE = RX_RING_SIZE;
+    static constexpr uint32_t TX_SIZE = TX_RING_SIZE;
+    static constexpr size_t RX_BUFFER_SIZE = PACKET_BUFFER_SIZE;
+
+    static constexpr uint64_t R_RX_BASE_LO = IntelX710Regs::RX_BASE_LO;
+    static constexpr uint64_t R_RX_BASE_HI = IntelX710Regs::RX_BASE_HI;
+    static constexpr uint64_t R_RX_HEAD    = IntelX710Regs::RX_HEAD;
+    static constexpr uint64_t R_RX_TAIL    = IntelX710Regs::RX_TAIL;
+    static constexpr uint64_t R_TX_BASE_LO = IntelX710Regs::TX_BASE_LO;
+    static constexpr uint64_t R_TX_BASE_HI = IntelX710Regs::TX_BASE_HI;
+    static constexpr uint64_t R_TX_HEAD    = IntelX710Regs::TX_HEAD;
+    static constexpr uint64_t R_TX_TAIL    = IntelX710Regs::TX_TAIL;
+
+    // No reset handshake in this driver's initialize()
+    static constexpr uint64_t R_CTRL = 0;
+    static constexpr uint32_t RESET_MASK = 0;
+
+    static bool rx_slot_free(const RxDesc& d) {
+        return !(d.status_flags & RX_DD_BIT);
+    }
+    static void fill_rx(RxDesc& d, size_t len, uint64_t ts) {
+        d.pkt_len = static_cast<uint16_t>(len);
+        d.hdr_len = 0;
+        d.timestamp = ts;  // Plays the PHC wire stamp
+    }
+    static void publish_rx(RxDesc& d) {
+        d.status_flags = RX_DD_BIT;
+    }
+    static size_t tx_len(const TxDesc& d) {
+        return (d.cmd_type_len >> 16) & 0xFFFF;
+    }
+    static bool tx_eop(const TxDesc& d) {
+        return (d.cmd_type_len & 1) != 0;
+    }
+    static void complete_tx(TxDesc& d) {
+        d.olinfo_status = TX_DD_BIT;
+    }
+};
+
+/**
+ * @brief Device model for ull_nic::ARM64NICDriver
+ */
+struct ARM64SimModel {
+    using Drv = ull_nic::ARM64NICDriver;
+    using RxDesc = Drv::RxDescriptor;
+    using TxDesc = Drv::TxDescriptor;
+
+    static constexpr uint32_t RX_SIZE = Drv::RX_RING_SIZE;
+    static constexpr uint32_t TX_SIZE = Drv::TX_RING_SIZE;
+    static constexpr size_t RX_BUFFER_SIZE = Drv::MAX_PACKET_SIZE;
+
+    static constexpr uint64_t R_RX_BASE_LO = Drv::REG_RX_DESC_BASE_LO;
+    static constexpr uint64_t R_RX_BASE_HI = Drv::REG_RX_DESC_BASE_HI;
+    static constexpr uint64_t R_RX_HEAD    = Drv::REG_RX_DESC_HEAD;
+    static constexpr uint64_t R_RX_TAIL    = Drv::REG_RX_DESC_TAIL;
+    static constexpr uint64_t R_TX_BASE_LO = Drv::REG_TX_DESC_BASE_LO;
+    static constexpr uint64_t R_TX_BASE_HI = Drv::REG_TX_DESC_BASE_HI;
+    static constexpr uint64_t R_TX_HEAD    = Drv::REG_TX_DESC_HEAD;
+    static constexpr uint64_t R_TX_TAIL    = Drv::REG_TX_DESC_TAIL;
+
+    static constexpr uint64_t R_CTRL = Drv::REG_CTRL;
+    static constexpr uint32_t RESET_MASK = Drv::CTRL_RESET;
+
+    static bool rx_slot_free(const RxDesc& d) {
+        return !(d.status & Drv::DESC_STATUS_DD);
+    }
+    static void fill_rx(RxDesc& d, size_t len, uint64_t ts) {
+        d.length = static_cast<uint16_t>(len);
+        d.checksum = 0;
+        d.rss_hash = 0;
+        d.timestamp = ts;
+    }
+    static void publish_rx(RxDesc& d) {
+        d.status = Drv::DESC_STATUS_DD | Drv::DESC_STATUS_EOP;
+    }
+    static size_t tx_len(const TxDesc& d) {
+        // The driver encodes `length | DESC_STATUS_EOP` into one field,
+        // so bit 1 is ambiguous between flag and length. Real hardware
+        // with this layout treats it as the flag; lengths therefore
+        // must keep bit 1 clear (the driver rounds frames anyway)
+        return (d.cmd_type_len & 0xFFFF) & ~Drv::DESC_STATUS_EOP;
+    }
+    static bool tx_eop(const TxDesc&) {
+        return true;  // Single-descriptor sends only (no SG in this driver)
+    }
+    static void complete_tx(TxDesc& d) {
+        d.status = Drv::DESC_STATUS_DD;
+    }
+};
+
+/**
+ * @brief Device model for ull_nic::BroadcomNetXtreme
+ */
+struct BroadcomSimModel {
+    using Drv = ull_nic::BroadcomNetXtreme;
+    using RxDesc = Drv::RxDescriptor;
+    using TxDesc = Drv::TxDescriptor;
+
+    static constexpr uint32_t RX_SIZE = Drv::RX_RING_SIZE;
+    static constexpr uint32_t TX_SIZE = Drv::TX_RING_SIZE;
+    static constexpr size_t RX_BUFFER_SIZE = Drv::MAX_PACKET_SIZE;
+
+    static constexpr uint64_t R_RX_BASE_LO = Drv::REG_RX_RING_BASE_LO;
+    static constexpr uint64_t R_RX_BASE_HI = Drv::REG_RX_RING_BASE_HI;
+    static constexpr uint64_t R_RX_HEAD    = Drv::REG_RX_RING_HEAD;
+    static constexpr uint64_t R_RX_TAIL    = Drv::REG_RX_RING_TAIL;
+    static constexpr uint64_t R_TX_BASE_LO = Drv::REG_TX_RING_BASE_LO;
+    static constexpr uint64_t R_TX_BASE_HI = Drv::REG_TX_RING_BASE_HI;
+    static constexpr uint64_t R_TX_HEAD    = Drv::REG_TX_RING_HEAD;
+    static constexpr uint64_t R_TX_TAIL    = Drv::REG_TX_RING_TAIL;
+
+    static constexpr uint64_t R_CTRL = Drv::REG_DEVICE_CONTROL;
+    static constexpr uint32_t RESET_MASK = Drv::CTRL_DEVICE_RESET;
+
+    static bool rx_slot_free(const RxDesc& d) {
+        return !(d.status & Drv::DESC_STATUS_DD);
+    }
+    static void fill_rx(RxDesc& d, size_t len, uint64_t ts) {
+        d.length = static_cast<uint16_t>(len);
+        d.checksum = 0;
+        d.errors = 0;
+        d.vlan_tag = 0;
+        d.rss_hash = 0;
+        d.timestamp_lo = static_cast<uint32_t>(ts);
+    }
+    static void publish_rx(RxDesc& d) {
+        d.status = Drv::DESC_STATUS_DD;
+    }
+    static size_t tx_len(const TxDesc& d) {
+        return d.cmd_type_len & 0xFFFF;  // Command bits live at 24+
+    }
+    static bool tx_eop(const TxDesc& d) {
+        return (d.cmd_type_len & Drv::DESC_CMD_EOP) != 0;
+    }
+    static void complete_tx(TxDesc& d) {
+        d.status = Drv::DESC_STATUS_DD;
+    }
+};
+
+// ============================================================================
+// Simulated NIC
+// ============================================================================
+
+/**
+ * @brief Software device behind a file-backed BAR0
+ *
+ * Lifecycle:
+ * @code
+ *   SimulatedNIC<IntelX710SimModel> sim;
+ *   sim.create();                          // Make the BAR0 file
+ *   sim.set_tx_sink([](const uint8_t* f, size_t n) { ... });
+ *
+ *   CustomNICDriver<> nic;
+ *   nic.initialize(sim.bar0_path());       // Driver maps the same file
+ *   sim.map_dma_arena(nic.dma_arena());    // Teach the "IOMMU" the arena
+ *
+ *   sim.inject_rx(frame, len);             // Wire -> driver
+ *   nic.submit_tx(frame, len);
+ *   sim.pump();                            // Driver -> wire (sink called)
+ * @endcode
+ *
+ * For ARM64NICDriver / BroadcomNetXtreme, wrap initialize() in
+ * start()/stop() so the reset handshake is serviced, then pump()
+ * manually; their identity DMA addressing needs no map_dma_arena().
+ *
+ * Threading: pump()/inject_rx() from one device thread at a time; the
+ * driver runs in any other thread, exactly like real hardware runs
+ * concurrently with the host CPU.
+ */
+template<typename Model>
+class SimulatedNIC {
+public:
+    /// Frame sink for transmitted packets (gathered SG chains arrive whole)
+    using TxSink = std::function<void(const uint8_t* frame, size_t len)>;
+
+    /// Matches the fixed 8 MB mapping CustomNICDriver::initialize() uses
+    static constexpr size_t BAR0_SIZE = 0x800000;
+
+    /// Gather limit for one TX frame (jumbo-sized, covers every driver)
+    static constexpr size_t MAX_FRAME_SIZE = 9216;
+
+    SimulatedNIC() = default;
+    ~SimulatedNIC() { destroy(); }
+
+    SimulatedNIC(const SimulatedNIC&) = delete;
+    SimulatedNIC& operator=(const SimulatedNIC&) = delete;
+
+    /**
+     * @brief Create the BAR0 backing file and map the device side
+     *
+     * The file is what stands in for the PCI resource: the driver opens
+     * the same path and mmaps MAP_SHARED, so register writes cross
+     * between driver and device as ordinary coherent stores.
+     */
+    bool create() {
+        std::snprintf(bar0_path_, sizeof(bar0_path_),
+                      "/tmp/ull_nic_sim_bar0_XXXXXX");
+        int fd = mkstemp(bar0_path_);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, BAR0_SIZE) != 0) {
+            close(fd);
+            return false;
+        }
+        bar0_ = static_cast<volatile uint8_t*>(
+            mmap(nullptr, BAR0_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+        );
+        close(fd);
+        if (bar0_ == MAP_FAILED) {
+            bar0_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Unmap and delete the BAR0 file (idempotent) */
+    void destroy() {
+        stop();
+        if (bar0_) {
+            munmap(const_cast<uint8_t*>(bar0_), BAR0_SIZE);
+            bar0_ = nullptr;
+            unlink(bar0_path_);
+        }
+    }
+
+    /** @brief Path to hand the driver as its "PCI resource" */
+    const char* bar0_path() const { return bar0_path_; }
+
+    /** @brief Install the sink transmitted frames are delivered to */
+    void set_tx_sink(TxSink sink) { tx_sink_ = std::move(sink); }
+
+    /**
+     * @brief Register one bus -> host DMA translation window
+     *
+     * Adjacent windows coalesce, so a physically contiguous arena costs
+     * one entry regardless of page count. Addresses with no window fall
+     * back to identity (covers the drivers whose get_physical_addr()
+     * returns the virtual address).
+     */
+    void map_dma(uint64_t bus_addr, void* host_addr, size_t len) {
+        uint8_t* host = static_cast<uint8_t*>(host_addr);
+        if (!windows_.empty()) {
+            DmaWindow& last = windows_.back();
+            if (bus_addr == last.bus + last.len &&
+                host == last.host + last.len) {
+                last.len += len;  // Coalesce the common contiguous case
+                return;
+            }
+        }
+        windows_.push_back(DmaWindow{bus_addr, host, len});
+        // Keep sorted by bus address for the lookup below
+        for (size_t i = windows_.size(); i > 1; i--) {
+            if (windows_[i - 1].bus < windows_[i - 2].bus) {
+                std::swap(windows_[i - 1], windows_[i - 2]);
+            } else {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Register every page of a DmaArena
+     *
+     * CustomNICDriver publishes real pagemap physical addresses; pages
+     * of one mapping need not be physically contiguous, so each page
+     * gets its own window (coalescing collapses runs that are).
+     */
+    void map_dma_arena(const DmaArena& arena) {
+        uint8_t* base = arena.base();
+        const size_t page = arena.page_size();
+        for (size_t off = 0; off < arena.size(); off += page) {
+            map_dma(arena.virt_to_phys(base + off), base + off, page);
+        }
+    }
+
+    /**
+     * @brief Service the device once: reset handshake, then TX ring
+     *
+     * All device-side cursor state lives in the head registers
+     * themselves - the simulator is stateless between calls, just like
+     * the loopback_pump() precedent.
+     *
+     * @return Number of frames transmitted this call
+     */
+    size_t pump() {
+        if (!bar0_) {
+            return 0;
+        }
+
+        // Reset handshake: the driver asserts the bit and spins until
+        // the device clears it (skipped entirely for layouts without one)
+        if constexpr (Model::RESET_MASK != 0) {
+            uint32_t ctrl = reg_read(Model::R_CTRL);
+            if (ctrl & Model::RESET_MASK) {
+                reg_write(Model::R_CTRL, ctrl & ~Model::RESET_MASK);
+            }
+        }
+
+        return service_tx();
+    }
+
+    /**
+     * @brief Deliver one frame into the driver's RX ring ("the wire")
+     *
+     * Hardware-faithful publication order: payload and descriptor
+     * fields first, release fence, THEN the DD bit, THEN the head
+     * register. A concurrently polling driver can observe any prefix
+     * of that sequence and stays correct.
+     *
+     * @param frame Payload to deliver (truncated to the ring's buffer size)
+     * @param len Payload length
+     * @param timestamp_ns Wire timestamp for the descriptor (0 = stamp
+     *        with get_wall_time_ns(), playing the PHC)
+     * @return false if the ring is not programmed yet or the next slot
+     *         is still owned by software (backpressure - counted in
+     *         rx_dropped())
+     */
+    bool inject_rx(const uint8_t* frame, size_t len, uint64_t timestamp_ns = 0) {
+        uint64_t ring_bus = reg_read64(Model::R_RX_BASE_LO, Model::R_RX_BASE_HI);
+        if (!bar0_ || ring_bus == 0) {
+            return false;
+        }
+        auto* ring = reinterpret_cast<typename Model::RxDesc*>(dma(ring_bus));
+
+        uint32_t head = reg_read(Model::R_RX_HEAD);
+        const uint32_t tail = reg_read(Model::R_RX_TAIL);
+
+        // Never advance the head register onto the software tail: a
+        // fully wrapped head would equal the poller's cursor and read
+        // as an EMPTY ring. Real NICs keep the same one-slot gap
+        if (((head + 1) & (Model::RX_SIZE - 1)) == tail) {
+            rx_dropped_++;  // Ring full - real silicon drops here too
+            return false;
+        }
+
+        typename Model::RxDesc& desc = ring[head];
+        if (!Model::rx_slot_free(desc)) {
+            rx_dropped_++;  // Slot still owned by software
+            return false;
+        }
+
+        uint8_t* buf = dma(desc.buffer_addr);
+        size_t copy = (len < Model::RX_BUFFER_SIZE) ? len : Model::RX_BUFFER_SIZE;
+        std::memcpy(buf, frame, copy);
+
+        if (timestamp_ns == 0) {
+            timestamp_ns = ull_nic::get_wall_time_ns();
+        }
+        Model::fill_rx(desc, copy, timestamp_ns);
+
+        // Payload + fields strictly before DD, DD strictly before head
+        std::atomic_thread_fence(std::memory_order_release);
+        Model::publish_rx(desc);
+        std::atomic_thread_fence(std::memory_order_release);
+        reg_write(Model::R_RX_HEAD, (head + 1) & (Model::RX_SIZE - 1));
+
+        rx_injected_++;
+        return true;
+    }
+
+    /**
+     * @brief Run the device on a background thread
+     *
+     * Needed while a driver's initialize() blocks on the reset
+     * handshake; tests switch back to manual pump() afterwards for
+     * determinism. sched_yield() keeps the handshake live on
+     * single-core boxes.
+     */
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        service_thread_ = std::thread([this] {
+            while (running_.load(std::memory_order_acquire)) {
+                pump();
+                sched_yield();
+            }
+        });
+    }
+
+    /** @brief Stop the background device thread (idempotent) */
+    void stop() {
+        if (running_.exchange(false) && service_thread_.joinable()) {
+            service_thread_.join();
+        }
+    }
+
+    // Device-side counters (test assertions / debugging)
+    uint64_t tx_frames() const { return tx_frames_; }
+    uint64_t rx_injected() const { return rx_injected_; }
+    uint64_t rx_dropped() const { return rx_dropped_; }
+
+private:
+    struct DmaWindow {
+        uint64_t bus;
+        uint8_t* host;
+        size_t len;
+    };
+
+    /**
+     * @brief Walk the TX ring from the device head to the driver's tail
+     *
+     * Gathers descriptor chains (EOP-terminated) into one frame, hands
+     * it to the sink, completes the chain's descriptors, and only then
+     * publishes the new head register - the order the drivers' reclaim
+     * paths assume.
+     */
+    size_t service_tx() {
+        uint64_t ring_bus = reg_read64(Model::R_TX_BASE_LO, Model::R_TX_BASE_HI);
+        if (ring_bus == 0) {
+            return 0;  // Ring not programmed yet
+        }
+        auto* ring = reinterpret_cast<typename Model::TxDesc*>(dma(ring_bus));
+
+        uint32_t head = reg_read(Model::R_TX_HEAD);
+        const uint32_t tail = reg_read(Model::R_TX_TAIL);
+
+        size_t frames = 0;
+        while (head != tail) {
+            size_t total = 0;
+            bool eop = false;
+            do {
+                typename Model::TxDesc& desc = ring[head];
+                size_t seg_len = Model::tx_len(desc);
+                eop = Model::tx_eop(desc);
+
+                const uint8_t* src = dma(desc.buffer_addr);
+                size_t room = (total < MAX_FRAME_SIZE)
+                            ? MAX_FRAME_SIZE - total : 0;
+                size_t copy = (seg_len < room) ? seg_len : room;
+                if (copy > 0 && src) {
+                    std::memcpy(frame_buf_ + total, src, copy);
+                }
+                total += seg_len;
+
+                // Payload read before DD - the driver recycles the
+                // buffer the instant it sees the bit
+                std::atomic_thread_fence(std::memory_order_release);
+                Model::complete_tx(desc);
+
+                head = (head + 1) & (Model::TX_SIZE - 1);
+            } while (!eop && head != tail);
+
+            if (tx_sink_) {
+                tx_sink_(frame_buf_,
+                         (total < MAX_FRAME_SIZE) ? total : MAX_FRAME_SIZE);
+            }
+            tx_frames_++;
+            frames++;
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        reg_write(Model::R_TX_HEAD, head);
+        return frames;
+    }
+
+    /** @brief Bus -> host translation (window table, identity fallback) */
+    uint8_t* dma(uint64_t bus_addr) const {
+        // Windows are few (coalesced) - linear scan beats binary search
+        // at this size and never misjudges the boundary
+        for (const DmaWindow& w : windows_) {
+            if (bus_addr >= w.bus && bus_addr < w.bus + w.len) {
+                return w.host + (bus_addr - w.bus);
+            }
+            if (w.bus > bus_addr) {
+                break;  // Sorted - no later window can match
+            }
+        }
+        return reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(bus_addr));
+    }
+
+    uint32_t reg_read(uint64_t offset) const {
+        return *reinterpret_cast<volatile uint32_t*>(bar0_ + offset);
+    }
+
+    void reg_write(uint64_t offset, uint32_t value) {
+        *reinterpret_cast<volatile uint32_t*>(bar0_ + offset) = value;
+    }
+
+    uint64_t reg_read64(uint64_t lo_offset, uint64_t hi_offset) const {
+        return static_cast<uint64_t>(reg_read(lo_offset)) |
+               (static_cast<uint64_t>(reg_read(hi_offset)) << 32);
+    }
+
+    volatile uint8_t* bar0_ = nullptr;
+    char bar0_path_[64] = {0};
+
+    std::vector<DmaWindow> windows_;
+    TxSink tx_sink_;
+    uint8_t frame_buf_[MAX_FRAME_SIZE];
+
+    std::thread service_thread_;
+    std::atomic<bool> running_{false};
+
+    uint64_t tx_frames_ = 0;
+    uint64_t rx_injected_ = 0;
+    uint64_t rx_dropped_ = 0;
+};
+
+} // namespace hardware
+} // namespace hft
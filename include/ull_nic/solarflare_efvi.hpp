@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common_types.hpp"
+#include "latency_histogram.hpp"
 #include <cstdint>
 #include <cstring>
 #include <array>
@@ -68,6 +69,8 @@ constexpr size_t EFVI_RX_RING_SIZE = 512;  // RX descriptor ring size
 constexpr size_t EFVI_TX_RING_SIZE = 512;  // TX descriptor ring size
 constexpr size_t EFVI_PKT_BUF_SIZE = 2048; // Packet buffer size (standard MTU)
 constexpr size_t EFVI_NUM_BUFS = 1024;     // Total packet buffers
+constexpr size_t EFVI_EVENT_BURST = 32;    // Max events drained per poll
+constexpr size_t EFVI_REFILL_BATCH = 16;   // RX buffers re-posted per push
 
 // ============================================================================
 // Simulated ef_vi Structures (Real Implementation Uses Actual ef_vi API)
@@ -142,7 +145,17 @@ public:
      * ```
      */
     SolarflareEFVI() : initialized_(false), rx_posted_(0), tx_posted_(0) {}
-    
+
+    ~SolarflareEFVI() {
+        if (initialized_) {
+            free_packet_buffers();
+        }
+    }
+
+    SolarflareEFVI(const SolarflareEFVI&) = delete;
+    SolarflareEFVI& operator=(const SolarflareEFVI&) = delete;
+
+
     /**
      * Initialize NIC with ef_vi
      * 
@@ -152,8 +165,14 @@ public:
     bool initialize(const char* interface) {
         // Production: Open ef_vi interface
         // For simulation, just mark initialized
+        (void)interface;
         initialized_ = true;
-        
+
+        // Warm the calibrated TSC clock here so the first hot-path
+        // histogram record never pays the one-time calibration
+        ull_nic::tsc_clock();
+
+
         // Pre-allocate packet buffers (huge pages for DMA)
         allocate_packet_buffers();
         
@@ -187,12 +206,14 @@ public:
         if (!initialized_) [[unlikely]] {
             return false;
         }
-        
+
         // HOT PATH: Check DMA ring buffer for new packets
         // Real implementation: ef_eventq_poll()
         // Simulation: Return dummy data
-        
+
         if (rx_posted_ > 0) [[likely]] {
+            const uint64_t t0 = ull_nic::get_timestamp();
+
             // Simulated packet receive
             pkt->len = 64;  // Minimum Ethernet frame
             #if defined(__x86_64__) || defined(__i386__)
@@ -201,15 +222,112 @@ public:
                 pkt->timestamp_ns = 0;  // Placeholder for non-x86
             #endif
             rx_posted_--;
-            
-            // Re-post RX buffer immediately (keep ring full)
-            post_rx_buffer(rx_posted_);
-            
+
+            // Deferred refill: queue the consumed buffer, repost in
+            // batches (one descriptor push amortized over
+            // EFVI_REFILL_BATCH buffers instead of one per packet)
+            defer_rx_refill(rx_posted_);
+
+            // Tail instrumentation: per-packet RX path time into the
+            // log-bucketed histogram (P99/P99.9 readable off-core)
+            rx_histogram_.record(
+                ull_nic::tsc_clock().to_ns(ull_nic::get_timestamp() - t0));
+
             return true;
         }
-        
+
         return false;
     }
+
+    /**
+     * Drain the event queue in one pass (the ef_vi-native poll shape)
+     *
+     * ef_vi's performance model is built around ef_eventq_poll()
+     * returning MANY events per call: one poll amortizes across the
+     * whole burst, and a single EF_EVENT_TYPE_RX_MULTI / TX event can
+     * cover dozens of descriptors. Per-packet poll_rx() pays the full
+     * poll cost for every frame - during a market-open burst that is
+     * the difference between keeping up and overflowing the RX ring.
+     *
+     * This drain services BOTH directions: RX events fill `out` and TX
+     * completion events release TX descriptors, so the hot loop makes
+     * one call instead of poll_rx() + poll_tx_completions().
+     *
+     * Consumed RX buffers are NOT re-posted here - they accumulate and
+     * go back to the NIC in EFVI_REFILL_BATCH groups (one doorbell
+     * push per group, see defer_rx_refill).
+     *
+     * Production:
+     * ```cpp
+     * ef_event evs[EFVI_EVENT_BURST];
+     * int n_ev = ef_eventq_poll(&vi, evs, EFVI_EVENT_BURST);
+     * for (int i = 0; i < n_ev; i++) {
+     *     switch (EF_EVENT_TYPE(evs[i])) {
+     *     case EF_EVENT_TYPE_RX:
+     *         // unpack pkt_id -> buffer, len; emit to out[]
+     *         break;
+     *     case EF_EVENT_TYPE_TX:
+     *         n = ef_vi_transmit_unbundle(&vi, &evs[i], ids);
+     *         // n TX buffers free in ONE event
+     *         break;
+     *     }
+     * }
+     * ```
+     *
+     * @param out Array of at least `max` packet slots
+     * @param max Upper bound on packets returned (<= EFVI_EVENT_BURST
+     *            is the natural size)
+     * @return Number of packets written to `out`
+     */
+    inline size_t poll_rx_burst(efvi_packet* out, size_t max) {
+        if (!initialized_) [[unlikely]] {
+            return 0;
+        }
+
+        const uint64_t t0 = ull_nic::get_timestamp();
+
+        // --- TX side of the drain -------------------------------------
+        // Real implementation: EF_EVENT_TYPE_TX events unbundle into
+        // batches of completed descriptors. Simulation: everything
+        // submitted before this drain has left the wire.
+        tx_posted_ = 0;
+
+        // --- RX side of the drain -------------------------------------
+        const size_t budget =
+            (max < EFVI_EVENT_BURST) ? max : EFVI_EVENT_BURST;
+        size_t n = 0;
+        while (n < budget && rx_posted_ > 0) {
+            out[n].len = 64;  // Simulated minimum Ethernet frame
+            #if defined(__x86_64__) || defined(__i386__)
+                out[n].timestamp_ns = __rdtsc();
+            #else
+                out[n].timestamp_ns = 0;
+            #endif
+            rx_posted_--;
+            defer_rx_refill(rx_posted_);
+            n++;
+        }
+
+        if (n > 0) [[likely]] {
+            // One histogram record for the whole drain - the per-packet
+            // figure is drain_time / n, but what the tail cares about
+            // is how long the loop was away from the event queue
+            rx_histogram_.record(
+                ull_nic::tsc_clock().to_ns(ull_nic::get_timestamp() - t0));
+        }
+
+        return n;
+    }
+
+    /**
+     * RX-path latency histogram (record happens inside poll_rx)
+     *
+     * A control thread may snapshot()/dump() this without stopping the
+     * polling thread - see latency_histogram.hpp.
+     */
+    const ull_nic::LatencyHistogram& rx_latency_histogram() const {
+        return rx_histogram_;
+    }
     
     /**
      * Submit packet for transmission (zero-copy)
@@ -270,12 +388,31 @@ public:
      * ```
      */
     inline void poll_tx_completions() {
+        // NOTE: poll_rx_burst() services TX completions in the same
+        // event-queue drain - a loop using the burst API never needs
+        // this call. It remains for TX-only paths (e.g. an order
+        // gateway thread that does not receive).
         if (tx_posted_ > 0) [[likely]] {
             // Real implementation: ef_eventq_poll() for TX events
             // For simulation, just decrement counter
             tx_posted_--;
         }
     }
+
+    /**
+     * Push any accumulated RX refills to the NIC now
+     *
+     * The deferred refill normally flushes itself every
+     * EFVI_REFILL_BATCH buffers; call this before parking the polling
+     * thread (end of session, mode switch) so the ring is not left
+     * short a partial batch.
+     */
+    inline void flush_rx_refills() {
+        if (pending_refill_count_ > 0) {
+            post_rx_buffers(pending_refill_ids_, pending_refill_count_);
+            pending_refill_count_ = 0;
+        }
+    }
     
     /**
      * Get hardware timestamp of last received packet
@@ -292,11 +429,31 @@ public:
         #endif
     }
 
+    /**
+     * Direct access to a registered packet buffer
+     *
+     * The delegated-send engine (TCPDirectConnection) carves its send
+     * pool out of these - they are already DMA-registered with the
+     * NIC, so a frame built here goes onto the TX ring with no copy
+     * and no per-send registration.
+     */
+    inline uint8_t* packet_buffer(size_t idx) {
+        return (idx < EFVI_NUM_BUFS)
+            ? static_cast<uint8_t*>(handle_.pkt_bufs[idx]) : nullptr;
+    }
+
 private:
     efvi_handle handle_;
     bool initialized_;
     uint32_t rx_posted_;
     uint32_t tx_posted_;
+
+    // Consumed RX buffer IDs waiting to be re-posted as one batch
+    uint32_t pending_refill_ids_[EFVI_REFILL_BATCH];
+    uint32_t pending_refill_count_ = 0;
+
+    // RX-path latency distribution (cache-resident, no alloc on record)
+    ull_nic::LatencyHistogram rx_histogram_;
     
     /**
      * Allocate packet buffers using huge pages
@@ -309,14 +466,23 @@ private:
     void allocate_packet_buffers() {
         // Real implementation: mmap() with MAP_HUGETLB
         // Allocate from huge page pool for DMA
+        // Simulation: cache-line-aligned heap buffers so the TX copy
+        // path actually works (and crashes loudly if misused)
         for (size_t i = 0; i < EFVI_NUM_BUFS; i++) {
-            handle_.pkt_bufs[i] = nullptr;  // Placeholder
+            handle_.pkt_bufs[i] = aligned_alloc(64, EFVI_PKT_BUF_SIZE);
+        }
+    }
+
+    void free_packet_buffers() {
+        for (size_t i = 0; i < EFVI_NUM_BUFS; i++) {
+            free(handle_.pkt_bufs[i]);
+            handle_.pkt_bufs[i] = nullptr;
         }
     }
     
     /**
      * Post RX buffer to NIC
-     * 
+     *
      * Production:
      * ```cpp
      * ef_vi_receive_init(&vi, dma_addr, pkt_id);
@@ -326,6 +492,40 @@ private:
     inline void post_rx_buffer(uint32_t buf_id) {
         rx_posted_++;
         // Real implementation: ef_vi_receive_init()
+        (void)buf_id;
+    }
+
+    /**
+     * Post a batch of RX buffers with ONE push
+     *
+     * receive_init() only writes descriptors to the host-side ring;
+     * it's receive_push() - the doorbell equivalent - that costs an
+     * uncached PCIe write. Initing 16 descriptors and pushing once
+     * pays that write 1/16th as often as the per-packet repost.
+     *
+     * Production:
+     * ```cpp
+     * for (size_t i = 0; i < count; i++)
+     *     ef_vi_receive_init(&vi, dma_addr[ids[i]], ids[i]);
+     * ef_vi_receive_push(&vi);   // single push for the whole batch
+     * ```
+     */
+    inline void post_rx_buffers(const uint32_t* ids, size_t count) {
+        (void)ids;
+        rx_posted_ += static_cast<uint32_t>(count);
+        // Real implementation: receive_init() x count, one receive_push()
+    }
+
+    /**
+     * Queue a consumed RX buffer for the next batched repost; flushes
+     * automatically once EFVI_REFILL_BATCH buffers have accumulated
+     */
+    inline void defer_rx_refill(uint32_t buf_id) {
+        pending_refill_ids_[pending_refill_count_++] = buf_id;
+        if (pending_refill_count_ == EFVI_REFILL_BATCH) {
+            post_rx_buffers(pending_refill_ids_, EFVI_REFILL_BATCH);
+            pending_refill_count_ = 0;
+        }
     }
 };
 
@@ -370,58 +570,370 @@ private:
  */
 class TCPDirectConnection {
 public:
+    // ------------------------------------------------------------------------
+    // Delegated-send layout constants
+    // ------------------------------------------------------------------------
+    static constexpr size_t ETH_HDR = 14;
+    static constexpr size_t IP_HDR = 20;           // No options
+    static constexpr size_t TCP_HDR = 20;          // No options on data path
+    static constexpr size_t HDR_BYTES = ETH_HDR + IP_HDR + TCP_HDR;
+    static constexpr size_t SEND_POOL_SIZE = 64;   // In-flight send limit
+    static constexpr size_t MAX_PAYLOAD = EFVI_PKT_BUF_SIZE - HDR_BYTES;
+
+    TCPDirectConnection() = default;
+
+    /**
+     * Bind to the ef_vi driver whose TX ring carries delegated sends.
+     * The send pool is carved from the TOP of the driver's registered
+     * packet buffers (the RX/TX hot paths allocate from the bottom),
+     * so every pool buffer is already DMA-mapped - no registration,
+     * no copy, at send time.
+     */
+    explicit TCPDirectConnection(SolarflareEFVI& vi) { attach(vi); }
+
+    void attach(SolarflareEFVI& vi) {
+        vi_ = &vi;
+        for (size_t i = 0; i < SEND_POOL_SIZE; i++) {
+            pool_[i] = vi.packet_buffer(EFVI_NUM_BUFS - SEND_POOL_SIZE + i);
+            in_flight_[i].used = false;
+        }
+    }
+
     /**
-     * Initialize TCPDirect connection
+     * Establish the connection and pre-build the header template
+     *
+     * Production split of labor (this is the whole delegated-send
+     * idea): the KERNEL socket does the handshake and owns connection
+     * state - congestion window, retransmit timers, peer options - but
+     * the payload bytes go out through the ef_vi TX ring, bypassing
+     * the kernel on the latency-critical send:
+     *
+     * ```cpp
+     * fd = socket(AF_INET, SOCK_STREAM, 0);   // Normal kernel socket
+     * ::connect(fd, ...);                     // Kernel handshake
+     * onload_delegated_send_prepare(fd, ...); // Kernel lends us the
+     *                                         // right to send `window`
+     *                                         // bytes on the wire
+     * ```
+     *
+     * After the handshake we snapshot everything that does NOT change
+     * per-send into a 54-byte frame template and pre-sum the constant
+     * part of the TCP checksum, so the per-send cost is: patch seq,
+     * add the variable words, sum the payload - no full header build.
      */
     bool connect(const char* host, uint16_t port) {
-        // Production: zft_connect()
+        (void)host;
+        // Production: kernel socket handshake + delegated-send prepare.
+        // Simulation: synthesize connection parameters.
+        local_seq_ = 0x10000001;
+        peer_ack_ = 0x20000001;
         connected_ = true;
+
+        build_header_template(port);
         return true;
     }
-    
+
+    /**
+     * Claim a send buffer from the registered pool
+     *
+     * Build the order payload directly at the returned pointer - it
+     * sits HDR_BYTES into a DMA-registered frame, so send_delegated()
+     * later transmits in place. Returns nullptr when all
+     * SEND_POOL_SIZE buffers are awaiting ACKs (back-pressure: the
+     * kernel hasn't freed window, don't send).
+     */
+    inline uint8_t* acquire_send_buffer() {
+        for (size_t i = 0; i < SEND_POOL_SIZE; i++) {
+            const size_t idx = (pool_cursor_ + i) & (SEND_POOL_SIZE - 1);
+            if (!in_flight_[idx].used) {
+                pool_cursor_ = (idx + 1) & (SEND_POOL_SIZE - 1);
+                last_acquired_ = idx;
+                return pool_[idx] + HDR_BYTES;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Delegated send: patch the pre-built headers and hit the TX ring
+     *
+     * Per-send work, in full:
+     *   1. memcpy the 54-byte template to the front of the frame
+     *   2. patch IP total-length and IP checksum (incremental - the
+     *      checksum DELTA for the length field, not a 20-byte resum)
+     *   3. patch TCP seq; fold the pre-summed constant part with the
+     *      variable words (seq/ack/len) and the payload sum
+     *   4. submit to the ef_vi TX ring
+     *
+     * That is the 300ns path. The 2us path this replaces went
+     * write() -> syscall -> tcp_sendmsg -> skb alloc -> qdisc.
+     *
+     * The frame stays in the pool until the kernel reports the peer's
+     * ACK (handle_ack) - it IS the retransmit store.
+     *
+     * @param payload Pointer previously returned by acquire_send_buffer()
+     * @param len     Payload bytes written there
+     */
+    inline bool send_delegated(const uint8_t* payload, size_t len) {
+        if (!connected_ || len > MAX_PAYLOAD) [[unlikely]] {
+            return false;
+        }
+
+        const size_t idx = last_acquired_;
+        uint8_t* frame = pool_[idx];
+        if (payload != frame + HDR_BYTES) [[unlikely]] {
+            return false;  // Not a pool buffer we handed out
+        }
+
+        // 1. Stamp the template
+        std::memcpy(frame, hdr_template_, HDR_BYTES);
+
+        // 2. IP total length + incremental checksum (RFC 1624:
+        //    HC' = ~(~HC + ~m + m') for the one changed 16-bit field)
+        const uint16_t ip_len = static_cast<uint16_t>(IP_HDR + TCP_HDR + len);
+        store_be16(frame + ETH_HDR + 2, ip_len);
+        uint32_t hc = static_cast<uint16_t>(~template_ip_csum_);
+        hc += static_cast<uint16_t>(~template_ip_len_) & 0xffff;
+        hc += ip_len;
+        store_be16(frame + ETH_HDR + 10,
+                   static_cast<uint16_t>(~fold_csum(hc)));
+
+        // 3. TCP seq/ack + checksum: constant part was pre-summed at
+        //    connect; add only what varies per send
+        store_be32(frame + ETH_HDR + IP_HDR + 4, local_seq_);
+        store_be32(frame + ETH_HDR + IP_HDR + 8, peer_ack_);
+
+        uint32_t sum = tcp_csum_const_;
+        sum += static_cast<uint16_t>(TCP_HDR + len);  // Pseudo-hdr length
+        sum += local_seq_ >> 16;
+        sum += local_seq_ & 0xffff;
+        sum += peer_ack_ >> 16;
+        sum += peer_ack_ & 0xffff;
+        sum += sum16(payload, len);
+        store_be16(frame + ETH_HDR + IP_HDR + 16,
+                   static_cast<uint16_t>(~fold_csum(sum)));
+
+        // 4. Onto the wire. Production: ef_vi_transmit() with the
+        //    buffer's pre-registered DMA address + transmit_push.
+        if (vi_ && !vi_->submit_tx(frame, HDR_BYTES + len)) [[unlikely]] {
+            return false;  // TX ring full - caller retries after drain
+        }
+
+        in_flight_[idx].used = true;
+        in_flight_[idx].seq = local_seq_;
+        in_flight_[idx].len = static_cast<uint16_t>(len);
+        local_seq_ += static_cast<uint32_t>(len);
+        return true;
+    }
+
+    /**
+     * Reconcile with the kernel socket: peer ACK'd up to `ack_seq`
+     *
+     * Production: the kernel still receives the peer's ACKs (RX of the
+     * connection stays on the normal socket) and
+     * onload_delegated_send_complete() tells it which bytes we put on
+     * the wire ourselves, so its state machine matches reality. Here
+     * we release every pool buffer whose payload is fully covered.
+     */
+    inline void handle_ack(uint32_t ack_seq) {
+        for (size_t i = 0; i < SEND_POOL_SIZE; i++) {
+            if (in_flight_[i].used &&
+                static_cast<int32_t>(
+                    ack_seq - (in_flight_[i].seq + in_flight_[i].len)) >= 0) {
+                in_flight_[i].used = false;
+            }
+        }
+    }
+
+    /**
+     * Retransmit everything not yet ACK'd
+     *
+     * The kernel's retransmit timer fired (it knows - it's tracking
+     * the ACK stream). Frames are still intact in the pool with their
+     * headers already patched; they go straight back onto the TX ring.
+     *
+     * @return Number of frames re-sent
+     */
+    inline size_t retransmit_unacked() {
+        size_t n = 0;
+        for (size_t i = 0; i < SEND_POOL_SIZE; i++) {
+            if (in_flight_[i].used && vi_) {
+                vi_->submit_tx(pool_[i],
+                               HDR_BYTES + in_flight_[i].len);
+                n++;
+            }
+        }
+        return n;
+    }
+
+    /** Bytes sent but not yet ACK'd (kernel window reconciliation) */
+    inline size_t unacked_sends() const {
+        size_t n = 0;
+        for (size_t i = 0; i < SEND_POOL_SIZE; i++) {
+            n += in_flight_[i].used ? 1 : 0;
+        }
+        return n;
+    }
+
     /**
      * Zero-copy receive
-     * 
+     *
      * Performance: 0.15-0.20 μs
      */
     inline ssize_t receive_zerocopy(uint8_t** data, size_t max_len) {
         if (!connected_) [[unlikely]] {
             return -1;
         }
-        
+
         // Production: zft_zc_recv()
         // Returns pointer to DMA buffer (no copy!)
-        
+        (void)max_len;
+
         // Simulation
         static uint8_t dummy[1024];
         *data = dummy;
         return 64;
     }
-    
+
     /**
      * Release zero-copy buffer
-     * 
+     *
      * Performance: 10-20 ns
      */
     inline void release_buffer(uint8_t* data) {
         // Production: zft_zc_recv_done()
+        (void)data;
     }
-    
+
     /**
-     * Zero-copy send
-     * 
-     * Performance: 0.10-0.15 μs
+     * Zero-copy send (compatibility wrapper)
+     *
+     * One copy worse than the native path: prefer
+     * acquire_send_buffer() + build in place + send_delegated().
      */
     inline bool send_zerocopy(const uint8_t* data, size_t len) {
         if (!connected_) [[unlikely]] {
             return false;
         }
-        
-        // Production: zft_send()
-        return true;
+
+        uint8_t* buf = acquire_send_buffer();
+        if (!buf) [[unlikely]] {
+            return false;
+        }
+        std::memcpy(buf, data, len);
+        return send_delegated(buf, len);
     }
 
 private:
+    // ------------------------------------------------------------------------
+    // Checksum helpers (16-bit ones'-complement arithmetic)
+    // ------------------------------------------------------------------------
+
+    static inline uint32_t sum16(const uint8_t* p, size_t len) {
+        uint32_t sum = 0;
+        while (len >= 2) {
+            sum += static_cast<uint32_t>((p[0] << 8) | p[1]);
+            p += 2;
+            len -= 2;
+        }
+        if (len) {
+            sum += static_cast<uint32_t>(p[0] << 8);
+        }
+        return sum;
+    }
+
+    static inline uint16_t fold_csum(uint32_t sum) {
+        while (sum >> 16) {
+            sum = (sum & 0xffff) + (sum >> 16);
+        }
+        return static_cast<uint16_t>(sum);
+    }
+
+    static inline void store_be16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v);
+    }
+
+    static inline void store_be32(uint8_t* p, uint32_t v) {
+        p[0] = static_cast<uint8_t>(v >> 24);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[2] = static_cast<uint8_t>(v >> 8);
+        p[3] = static_cast<uint8_t>(v);
+    }
+
+    /**
+     * Snapshot everything per-connection-constant into the 54-byte
+     * template and pre-sum the constant TCP checksum contribution
+     * (pseudo-header addresses/protocol + ports + offset/flags +
+     * window). send_delegated() only adds seq, ack, length and the
+     * payload.
+     */
+    void build_header_template(uint16_t port) {
+        std::memset(hdr_template_, 0, sizeof(hdr_template_));
+
+        // Ethernet: MACs come from ARP via the kernel in production
+        store_be16(hdr_template_ + 12, 0x0800);          // IPv4
+
+        // IPv4
+        uint8_t* ip = hdr_template_ + ETH_HDR;
+        ip[0] = 0x45;                                    // v4, IHL 5
+        template_ip_len_ = IP_HDR + TCP_HDR;             // Zero payload
+        store_be16(ip + 2, template_ip_len_);
+        ip[8] = 64;                                      // TTL
+        ip[9] = 6;                                       // TCP
+        const uint32_t saddr = 0x0a000001;               // Sim: 10.0.0.1
+        const uint32_t daddr = 0x0a000002;               // Sim: 10.0.0.2
+        store_be32(ip + 12, saddr);
+        store_be32(ip + 16, daddr);
+        template_ip_csum_ = static_cast<uint16_t>(
+            ~fold_csum(sum16(ip, IP_HDR)));
+        store_be16(ip + 10, template_ip_csum_);
+
+        // TCP
+        uint8_t* tcp = hdr_template_ + ETH_HDR + IP_HDR;
+        const uint16_t sport = 49152;
+        store_be16(tcp + 0, sport);
+        store_be16(tcp + 2, port);
+        tcp[12] = 0x50;                                  // Offset 5 words
+        tcp[13] = 0x18;                                  // PSH | ACK
+        store_be16(tcp + 14, 65535);                     // Window
+
+        // Constant checksum contribution: pseudo-header (addresses +
+        // protocol) plus the TCP words that never change per send
+        uint32_t sum = 0;
+        sum += saddr >> 16;
+        sum += saddr & 0xffff;
+        sum += daddr >> 16;
+        sum += daddr & 0xffff;
+        sum += 6;                                        // Protocol
+        sum += sport;
+        sum += port;
+        sum += static_cast<uint32_t>((tcp[12] << 8) | tcp[13]);
+        sum += 65535;                                    // Window
+        tcp_csum_const_ = sum;
+    }
+
+    // One frame awaiting its ACK - the pool buffer doubles as the
+    // retransmit store
+    struct InFlight {
+        uint32_t seq;
+        uint16_t len;
+        bool used;
+    };
+
+    SolarflareEFVI* vi_ = nullptr;
+    uint8_t* pool_[SEND_POOL_SIZE] = {};
+    InFlight in_flight_[SEND_POOL_SIZE] = {};
+    size_t pool_cursor_ = 0;
+    size_t last_acquired_ = 0;
+
+    uint8_t hdr_template_[HDR_BYTES] = {};
+    uint16_t template_ip_len_ = 0;
+    uint16_t template_ip_csum_ = 0;
+    uint32_t tcp_csum_const_ = 0;
+
+    uint32_t local_seq_ = 0;
+    uint32_t peer_ack_ = 0;
     bool connected_ = false;
 };
 
@@ -30,8 +30,15 @@
 
 // Driver implementations
 #include "custom_driver.hpp"
+#include "multiqueue_nic_driver.hpp"
 #include "solarflare_efvi.hpp"
 
+// Distribution and observability around the drivers
+#include "fanout_ring.hpp"
+#include "flow_steering.hpp"
+#include "capture.hpp"
+#include "tx_pacer.hpp"
+
 /**
  * @namespace ull_nic
  * @brief Ultra-Low-Latency NIC drivers namespace
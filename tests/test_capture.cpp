@@ -0,0 +1,149 @@
+/**
+ * CaptureWriter round-trip test
+ *
+ * Frames go in through the real hot-path capture() (streaming stores,
+ * fixed-slot segments), segments rotate to pcapng, and the pcapng
+ * comes back through PcapReplayer's indexer - the same parser replay
+ * uses in anger. Covered here:
+ *
+ * - Round trip: N captured frames reappear with identical payloads,
+ *   captured/original lengths, and exact nanosecond timestamps
+ *   (if_tsresol = 9 honored end to end)
+ * - Jumbo truncation: cap_len capped at SNAP_LEN, orig_len kept
+ * - Backpressure: with every segment full, capture() drops instead of
+ *   stalling; rotation frees the ring and capture resumes
+ */
+
+#include <ull_nic/capture.hpp>
+#include <ull_nic/pcap_replay.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using hft::hardware::CaptureWriter;
+using hft::PcapReplayer;
+
+namespace {
+
+constexpr const char* PREFIX = "/tmp/ull_nic_test_cap";
+constexpr size_t SEGMENTS = 2;
+constexpr size_t SLOTS = 64;
+constexpr uint64_t TS_BASE = 1'700'000'000'000'000'000ULL;  // Epoch ns
+
+// Distinct, position-dependent payload so misdelivery can't pass
+void fill_pattern(uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(seq * 31 + i);
+    }
+}
+
+bool check_pattern(const uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != static_cast<uint8_t>(seq * 31 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t frame_len(uint32_t seq) {
+    return 64 + (seq % 128);
+}
+
+std::string seg_file(size_t s) {
+    char path[256];
+    std::snprintf(path, sizeof(path), "%s_%03zu.seg", PREFIX, s);
+    return path;
+}
+
+std::string pcap_file(uint64_t n) {
+    char path[256];
+    std::snprintf(path, sizeof(path), "%s_%06llu.pcapng", PREFIX,
+                  static_cast<unsigned long long>(n));
+    return path;
+}
+
+} // namespace
+
+int main() {
+    CaptureWriter cap;
+    assert(cap.open(PREFIX, SEGMENTS, SLOTS));
+
+    uint8_t frame[4096];
+
+    // ── Round trip: one full segment -> pcapng -> PcapReplayer ──
+    for (uint32_t seq = 0; seq < SLOTS; seq++) {
+        fill_pattern(frame, frame_len(seq), seq);
+        assert(cap.capture(frame, frame_len(seq), TS_BASE + seq));
+    }
+    assert(cap.packets() == SLOTS);
+
+    cap.flush_active();
+    assert(cap.rotate_once() == 1);
+    assert(cap.segments_rotated() == 1);
+
+    {
+        PcapReplayer replay;
+        assert(replay.open(pcap_file(0), /*use_sidecar_index=*/false));
+        assert(replay.packet_count() == SLOTS);
+        for (uint32_t seq = 0; seq < SLOTS; seq++) {
+            const auto& ref = replay.packet(seq);
+            assert(ref.caplen == frame_len(seq));
+            assert(ref.orig_len == frame_len(seq));
+            // if_tsresol = 9: the descriptor's ns stamp survives exactly
+            assert(ref.timestamp_ns == TS_BASE + seq);
+            assert(check_pattern(replay.packet_data(seq), ref.caplen, seq));
+        }
+    }
+
+    // ── Jumbo frame: payload truncated to SNAP_LEN, orig_len honest ──
+    {
+        const size_t JUMBO = 3000;
+        fill_pattern(frame, JUMBO, 7);
+        assert(cap.capture(frame, JUMBO, TS_BASE + 1000));
+        cap.flush_active();
+        assert(cap.rotate_once() == 1);
+
+        PcapReplayer replay;
+        assert(replay.open(pcap_file(1), false));
+        assert(replay.packet_count() == 1);
+        assert(replay.packet(0).caplen == CaptureWriter::SNAP_LEN);
+        assert(replay.packet(0).orig_len == JUMBO);
+        assert(check_pattern(replay.packet_data(0),
+                             CaptureWriter::SNAP_LEN, 7));
+    }
+
+    // ── Backpressure: full ring drops, rotation revives capture ──
+    {
+        for (uint32_t seq = 0; seq < SEGMENTS * SLOTS; seq++) {
+            fill_pattern(frame, 64, seq);
+            assert(cap.capture(frame, 64, TS_BASE + 2000 + seq));
+        }
+        // Every segment is now full (or will be marked so by the flip
+        // attempt) - capture must drop, never stall the RX path
+        assert(!cap.capture(frame, 64, TS_BASE + 9999));
+        assert(cap.drops() == 1);
+
+        assert(cap.rotate_once() == SEGMENTS);
+        assert(cap.capture(frame, 64, TS_BASE + 10000));  // Revived
+
+        // The rotated files carry the backlog
+        PcapReplayer replay;
+        assert(replay.open(pcap_file(2), false));
+        assert(replay.packet_count() == SLOTS);
+        assert(replay.open(pcap_file(3), false));
+        assert(replay.packet_count() == SLOTS);
+    }
+
+    for (size_t s = 0; s < SEGMENTS; s++) {
+        std::remove(seg_file(s).c_str());
+    }
+    for (uint64_t n = 0; n < 4; n++) {
+        std::remove(pcap_file(n).c_str());
+    }
+
+    printf("test_capture OK\n");
+    return 0;
+}
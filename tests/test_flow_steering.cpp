@@ -0,0 +1,137 @@
+/**
+ * FlowSteeringTable behavior test (single-threaded)
+ *
+ * Drives the epoch-swap reader/writer protocol from one thread playing
+ * both roles: lookups publish the reader epoch exactly as the poller
+ * would, and each mutation copy-edits the shadow image and swaps.
+ * Covered here:
+ *
+ * - Lookup misses, hits, replacement and removal, via both the raw
+ *   (ip, port) path and the PacketView overload
+ * - The images really alternate: many mutations with interleaved
+ *   lookups stay consistent whichever image is active
+ * - Grace period: a mutation with NO intervening lookup (idle poller)
+ *   still completes via the bounded spin
+ * - The probe bound: MAX_PROBES keys in one neighborhood fit, the
+ *   next insert reports failure instead of degrading lookups
+ */
+
+#include <ull_nic/flow_steering.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+using hft::hardware::FlowSteeringTable;
+using hft::hardware::PacketView;
+
+namespace {
+
+// The table's published hash (Fibonacci multiplicative, top 9 bits) -
+// replicated so the test can craft colliding keys for the probe bound
+size_t bucket_of(uint32_t dst_ip, uint16_t dst_port) {
+    uint64_t key = (static_cast<uint64_t>(dst_ip) << 16) | dst_port;
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 55)
+           & FlowSteeringTable::BUCKET_MASK;
+}
+
+uint32_t ip(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    return (static_cast<uint32_t>(a) << 24) | (b << 16) | (c << 8) | d;
+}
+
+} // namespace
+
+int main() {
+    FlowSteeringTable flows;
+
+    // ── Miss on the empty table ──
+    assert(flows.lookup(ip(239, 1, 1, 5), 31337) ==
+           FlowSteeringTable::NO_CONSUMER);
+    assert(flows.size() == 0);
+
+    // ── Insert / hit / replace / remove ──
+    assert(flows.insert(ip(239, 1, 1, 5), 31337, 2));
+    flows.lookup(ip(239, 1, 1, 5), 31337);  // Poller publishes the epoch
+    assert(flows.insert(ip(239, 1, 1, 9), 31338, 4));
+
+    assert(flows.lookup(ip(239, 1, 1, 5), 31337) == 2);
+    assert(flows.lookup(ip(239, 1, 1, 9), 31338) == 4);
+    assert(flows.lookup(ip(239, 1, 1, 5), 31338) ==
+           FlowSteeringTable::NO_CONSUMER);  // Port is part of the key
+    assert(flows.size() == 2);
+
+    // The PacketView overload reaches the same entry
+    PacketView pkt{};
+    pkt.dst_ip = ip(239, 1, 1, 9);
+    pkt.dst_port = 31338;
+    assert(flows.lookup(pkt) == 4);
+
+    assert(flows.insert(ip(239, 1, 1, 5), 31337, 7));  // Re-subscribe
+    assert(flows.lookup(ip(239, 1, 1, 5), 31337) == 7);
+    assert(flows.size() == 2);
+
+    assert(flows.remove(ip(239, 1, 1, 5), 31337));
+    assert(flows.lookup(ip(239, 1, 1, 5), 31337) ==
+           FlowSteeringTable::NO_CONSUMER);
+    assert(flows.lookup(ip(239, 1, 1, 9), 31338) == 4);  // Survivor intact
+    assert(flows.size() == 1);
+
+    // ── Grace period with an idle poller: no lookup between swaps ──
+    // (the bounded spin proceeds; the shadow is quiescent by then)
+    assert(flows.insert(ip(239, 2, 2, 2), 10001, 0));
+    assert(flows.insert(ip(239, 2, 2, 3), 10002, 1));
+    assert(flows.lookup(ip(239, 2, 2, 2), 10001) == 0);
+    assert(flows.lookup(ip(239, 2, 2, 3), 10002) == 1);
+
+    // ── Images alternate: every mutation swaps, lookups stay right ──
+    for (uint16_t i = 0; i < 32; i++) {
+        assert(flows.insert(ip(239, 3, 0, static_cast<uint8_t>(i)),
+                            20000, i));
+        // Odd inserts read image 0, even inserts image 1 - both must
+        // hold the full subscription set after each swap
+        for (uint16_t j = 0; j <= i; j++) {
+            assert(flows.lookup(ip(239, 3, 0, static_cast<uint8_t>(j)),
+                                20000) == j);
+        }
+    }
+    for (uint16_t i = 0; i < 32; i++) {
+        assert(flows.remove(ip(239, 3, 0, static_cast<uint8_t>(i)), 20000));
+        flows.lookup(ip(239, 2, 2, 2), 10001);  // Keep the epoch fresh
+    }
+    assert(flows.size() == 3);
+
+    // ── Probe bound: MAX_PROBES colliders fit, one more is refused ──
+    {
+        const size_t target = bucket_of(ip(239, 9, 0, 0), 40000);
+        std::vector<std::pair<uint32_t, uint16_t>> colliders;
+        colliders.emplace_back(ip(239, 9, 0, 0), 40000);
+        for (uint32_t d = 1;
+             colliders.size() < FlowSteeringTable::MAX_PROBES + 1; d++) {
+            uint32_t addr = ip(239, 9, static_cast<uint8_t>(d >> 8),
+                               static_cast<uint8_t>(d));
+            if (bucket_of(addr, 40000) == target) {
+                colliders.emplace_back(addr, 40000);
+            }
+        }
+
+        for (size_t i = 0; i < FlowSteeringTable::MAX_PROBES; i++) {
+            assert(flows.insert(colliders[i].first, colliders[i].second,
+                                static_cast<uint16_t>(100 + i)));
+            flows.lookup(colliders[i].first, colliders[i].second);
+        }
+        // The neighborhood is full - insert refuses rather than letting
+        // lookups in this region degrade past the probe bound
+        assert(!flows.insert(colliders[FlowSteeringTable::MAX_PROBES].first,
+                             colliders[FlowSteeringTable::MAX_PROBES].second,
+                             999));
+
+        // Every accepted collider still resolves through the probes
+        for (size_t i = 0; i < FlowSteeringTable::MAX_PROBES; i++) {
+            assert(flows.lookup(colliders[i].first, colliders[i].second) ==
+                   100 + i);
+        }
+    }
+
+    printf("test_flow_steering OK\n");
+    return 0;
+}
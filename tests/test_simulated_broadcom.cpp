@@ -0,0 +1,138 @@
+/**
+ * BroadcomNetXtreme against the simulated NIC device
+ *
+ * Same shape as the ARM64 test - real initialize() with the reset
+ * handshake serviced by the device thread, manual pump() after - with
+ * the emphasis on COMPLETION ORDERING: descriptors must retire in
+ * submission order, the DD bits must land before the head register
+ * moves, and the driver's reclaim cursor must follow exactly.
+ */
+
+#include <ull_nic/simulated_nic.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using hft::hardware::BroadcomSimModel;
+using hft::hardware::SimulatedNIC;
+using ull_nic::BroadcomNetXtreme;
+
+namespace {
+
+void fill_pattern(uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(seq * 37 + i);
+    }
+}
+
+bool check_pattern(const uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != static_cast<uint8_t>(seq * 37 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    SimulatedNIC<BroadcomSimModel> sim;
+    assert(sim.create());
+
+    std::vector<std::vector<uint8_t>> wire;
+    sim.set_tx_sink([&](const uint8_t* frame, size_t len) {
+        wire.emplace_back(frame, frame + len);
+    });
+
+    BroadcomNetXtreme nic(sim.bar0_path());
+
+    sim.start();  // Services the CTRL_DEVICE_RESET handshake
+    bool up = nic.initialize();
+    sim.stop();
+    assert(up);
+
+    const uint32_t RX_SIZE = BroadcomNetXtreme::RX_RING_SIZE;
+    const uint32_t TX_SIZE = BroadcomNetXtreme::TX_RING_SIZE;
+
+    // ── RX delivery + wraparound across the 1024-slot ring ──
+    {
+        uint8_t frame[256];
+        uint32_t seq = 0;
+        const uint32_t total = 3 * RX_SIZE;
+
+        while (seq < total) {
+            uint32_t burst = (total - seq < 64) ? (total - seq) : 64;
+            for (uint32_t i = 0; i < burst; i++) {
+                size_t len = 64 + ((seq + i) % 128);
+                fill_pattern(frame, len, seq + i);
+                assert(sim.inject_rx(frame, len));
+            }
+            for (uint32_t i = 0; i < burst; i++) {
+                uint8_t* data;
+                uint16_t len;
+                assert(nic.receive_packet(&data, &len));
+                assert(len == 64 + ((seq + i) % 128));
+                assert(check_pattern(data, len, seq + i));
+            }
+            seq += burst;
+        }
+        assert(nic.get_packets_received() == total);
+    }
+
+    // ── Completion ordering: retire order == submission order ──
+    {
+        const uint32_t count = 200;
+        uint8_t frame[512];
+        for (uint32_t i = 0; i < count; i++) {
+            size_t len = 64 + (i % 256);
+            fill_pattern(frame, len, i);
+            assert(nic.send_packet(frame, static_cast<uint16_t>(len)));
+        }
+        assert(wire.empty());  // Nothing on the wire until the device runs
+
+        // Snapshot BEFORE the device runs: all posted, none retired
+        ull_nic::RingSnapshot s = nic.snapshot();
+        assert(s.sw_tx_tail == count);
+        assert(s.tx_in_flight == count);
+
+        assert(sim.pump() == count);
+        assert(wire.size() == count);
+        for (uint32_t i = 0; i < count; i++) {
+            assert(wire[i].size() == 64 + (i % 256));
+            assert(check_pattern(wire[i].data(), wire[i].size(), i));
+        }
+
+        // DD landed on every descriptor before the head register moved;
+        // the device-side head now matches the software tail
+        s = nic.snapshot();
+        assert(s.hw_tx_head == s.sw_tx_tail);
+        wire.clear();
+    }
+
+    // ── Full TX ring: refusal at capacity, recovery after retire ──
+    {
+        uint8_t frame[64];
+        fill_pattern(frame, sizeof(frame), 0);
+
+        uint32_t accepted = 0;
+        while (nic.send_packet(frame, sizeof(frame))) {
+            accepted++;
+            assert(accepted <= TX_SIZE);  // Guard against runaway
+        }
+        // One slot distinguishes full from empty; the 200 completions
+        // above were reclaimed lazily on the way
+        assert(accepted == TX_SIZE - 1);
+
+        assert(sim.pump() > 0);
+        assert(wire.size() == accepted);
+
+        assert(nic.send_packet(frame, sizeof(frame)));
+        assert(sim.pump() == 1);
+    }
+
+    printf("test_simulated_broadcom OK\n");
+    return 0;
+}
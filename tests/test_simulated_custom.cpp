@@ -0,0 +1,221 @@
+/**
+ * CustomNICDriver against the simulated NIC device
+ *
+ * The driver runs its REAL initialize() over the file-backed BAR0 -
+ * same mmap, same register programming, same DmaArena with genuine
+ * pagemap physical addresses (which is exactly what exercises the
+ * simulator's IOMMU window table). Covered here:
+ *
+ * - RX delivery and payload integrity across multiple ring laps
+ * - Full RX ring backpressure (device drops, then drains clean)
+ * - The RX_TAIL doorbell stays silent on an empty burst (head register
+ *   visible before the DD writeback - nothing consumed, no doorbell)
+ * - TX transmission order and payload integrity
+ * - Scatter-gather descriptor chains gathered into one wire frame
+ * - TX completion: in-flight depth falls only after the device
+ *   retires descriptors, observed through the public snapshot()
+ */
+
+#include <ull_nic/simulated_nic.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using hft::hardware::CustomNICDriver;
+using hft::hardware::IntelX710SimModel;
+using hft::hardware::RxView;
+using hft::hardware::SimulatedNIC;
+namespace reg = hft::hardware::reg;
+
+namespace {
+
+// Distinct, position-dependent payload so misdelivery can't pass
+void fill_pattern(uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(seq * 31 + i);
+    }
+}
+
+bool check_pattern(const uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != static_cast<uint8_t>(seq * 31 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    SimulatedNIC<IntelX710SimModel> sim;
+    assert(sim.create());
+
+    std::vector<std::vector<uint8_t>> wire;
+    sim.set_tx_sink([&](const uint8_t* frame, size_t len) {
+        wire.emplace_back(frame, frame + len);
+    });
+
+    CustomNICDriver<> nic;
+    assert(nic.initialize(sim.bar0_path()));
+    sim.map_dma_arena(nic.dma_arena());
+
+    const uint32_t RX_SIZE = hft::hardware::RX_RING_SIZE;
+
+    // ── RX delivery + wraparound: three full ring laps in bursts ──
+    {
+        uint8_t frame[256];
+        uint32_t seq = 0;
+        const uint32_t total = 3 * RX_SIZE;  // Head wraps twice
+
+        while (seq < total) {
+            uint32_t burst = (total - seq < 64) ? (total - seq) : 64;
+            for (uint32_t i = 0; i < burst; i++) {
+                size_t len = 64 + ((seq + i) % 128);
+                fill_pattern(frame, len, seq + i);
+                assert(sim.inject_rx(frame, len));
+            }
+            for (uint32_t i = 0; i < burst; i++) {
+                uint8_t* data;
+                size_t len;
+                assert(nic.poll_rx(&data, &len));
+                assert(len == 64 + ((seq + i) % 128));
+                assert(check_pattern(data, len, seq + i));
+            }
+            seq += burst;
+        }
+        assert(sim.rx_injected() == total);
+
+        uint8_t* data;
+        size_t len;
+        assert(!nic.poll_rx(&data, &len));  // Ring drained
+    }
+
+    // ── Full RX ring: device hits backpressure, then drains clean ──
+    {
+        uint8_t frame[64];
+        uint32_t accepted = 0;
+        while (true) {
+            fill_pattern(frame, sizeof(frame), accepted);
+            if (!sim.inject_rx(frame, sizeof(frame))) {
+                break;  // Next slot still owned by software
+            }
+            accepted++;
+        }
+        // One-slot gap against the tail, same as real hardware: a fully
+        // wrapped head would read back as an empty ring
+        assert(accepted == RX_SIZE - 1);
+        assert(sim.rx_dropped() == 1);
+
+        for (uint32_t i = 0; i < accepted; i++) {
+            uint8_t* data;
+            size_t len;
+            assert(nic.poll_rx(&data, &len));
+            assert(len == sizeof(frame));
+            assert(check_pattern(data, len, i));
+        }
+    }
+
+    // ── Empty burst: head register outran DD - doorbell must NOT ring ──
+    {
+        // Test-side view of the registers, to play the device
+        int bar_fd = open(sim.bar0_path(), O_RDWR);
+        assert(bar_fd >= 0);
+        auto* bar = static_cast<volatile uint8_t*>(
+            mmap(nullptr, SimulatedNIC<IntelX710SimModel>::BAR0_SIZE,
+                 PROT_READ | PROT_WRITE, MAP_SHARED, bar_fd, 0));
+        assert(bar != MAP_FAILED);
+        close(bar_fd);
+        auto reg32 = [bar](uint64_t off) -> volatile uint32_t& {
+            return *reinterpret_cast<volatile uint32_t*>(bar + off);
+        };
+
+        const uint32_t head = reg32(reg::RX_HEAD);
+        const uint32_t SENTINEL = 0xABCD1234;
+        reg32(reg::RX_TAIL) = SENTINEL;
+
+        // Device head advances but the slot's DD writeback is not
+        // visible yet (PCIe posts them independently)
+        reg32(reg::RX_HEAD) = (head + 1) & (RX_SIZE - 1);
+
+        RxView views[8];
+        assert(nic.poll_rx_burst(views, 8) == 0);
+        assert(reg32(reg::RX_TAIL) == SENTINEL);  // No spurious doorbell
+
+        // Restore, then a real frame rings the doorbell as usual
+        reg32(reg::RX_HEAD) = head;
+        uint8_t frame[64];
+        fill_pattern(frame, sizeof(frame), 0xDD);
+        assert(sim.inject_rx(frame, sizeof(frame)));
+        assert(nic.poll_rx_burst(views, 8) == 1);
+        assert(views[0].len == sizeof(frame));
+        assert(check_pattern(views[0].data, views[0].len, 0xDD));
+        assert(reg32(reg::RX_TAIL) == reg32(reg::RX_HEAD));
+
+        munmap(const_cast<uint8_t*>(bar),
+               SimulatedNIC<IntelX710SimModel>::BAR0_SIZE);
+    }
+
+    // ── TX: transmission order, payload integrity, completions ──
+    {
+        uint8_t frame[512];
+        const uint32_t count = 300;  // Crosses the lazy-reclaim threshold
+        for (uint32_t i = 0; i < count; i++) {
+            size_t len = 64 + (i % 256);
+            fill_pattern(frame, len, i);
+            assert(nic.submit_tx(frame, len));
+        }
+        // Device idle: everything posted is still in flight
+        assert(nic.tx_in_flight() == count);
+        assert(wire.empty());
+
+        assert(sim.pump() == count);
+        assert(wire.size() == count);
+        for (uint32_t i = 0; i < count; i++) {
+            assert(wire[i].size() == 64 + (i % 256));
+            assert(check_pattern(wire[i].data(), wire[i].size(), i));
+        }
+
+        // The next submit reclaims against the advanced hardware head
+        fill_pattern(frame, 64, count);
+        assert(nic.submit_tx(frame, 64));
+        assert(nic.tx_in_flight() == 1);
+
+        assert(sim.pump() == 1);
+        ull_nic::RingSnapshot s = nic.snapshot();
+        assert(s.hw_tx_head == s.sw_tx_tail);  // Device fully caught up
+        wire.clear();
+    }
+
+    // ── Scatter-gather: a chained frame arrives gathered and whole ──
+    {
+        uint8_t header[1500];
+        uint8_t payload[1500];
+        fill_pattern(header, sizeof(header), 7);
+        fill_pattern(payload, sizeof(payload), 9);
+
+        struct iovec segs[2];
+        segs[0].iov_base = header;
+        segs[0].iov_len = sizeof(header);
+        segs[1].iov_base = payload;
+        segs[1].iov_len = sizeof(payload);
+        assert(nic.submit_tx_sg(segs, 2));  // 3000B > one 2048B slot: chains
+
+        assert(sim.pump() == 1);  // One FRAME, two descriptors
+        assert(wire.size() == 1);
+        assert(wire[0].size() == sizeof(header) + sizeof(payload));
+        assert(check_pattern(wire[0].data(), sizeof(header), 7));
+        assert(check_pattern(wire[0].data() + sizeof(header),
+                             sizeof(payload), 9));
+    }
+
+    printf("test_simulated_custom OK\n");
+    return 0;
+}
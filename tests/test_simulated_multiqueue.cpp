@@ -0,0 +1,180 @@
+/**
+ * MultiQueueNICDriver against the simulated NIC device
+ *
+ * The driver runs its REAL initialize() + start_polling() over the
+ * file-backed BAR0: RSS programming, per-queue arena allocation from
+ * inside the pinned polling thread, and the per-queue ring protocol
+ * all execute unchanged. The simulator models queue 0 (its register
+ * offsets are exactly the queue-0 bank). Covered here:
+ *
+ * - RSS key + indirection table programming (round-robin over queues)
+ * - RX delivery through the real polling thread: payload, length and
+ *   PHC timestamp integrity in order
+ * - The RX_TAIL doorbell stays silent on an empty burst (head register
+ *   visible before the DD writeback - nothing consumed, no doorbell)
+ * - A non-empty burst rings the doorbell with the new software head
+ */
+
+#include <ull_nic/simulated_nic.hpp>
+#include <ull_nic/multiqueue_nic_driver.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using hft::hardware::IntelX710SimModel;
+using hft::hardware::MultiQueueNICDriver;
+using hft::hardware::SimulatedNIC;
+using hft::hardware::RxView;
+namespace reg = hft::hardware::reg;
+
+namespace {
+
+// Distinct, position-dependent payload so misdelivery can't pass
+void fill_pattern(uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = static_cast<uint8_t>(seq * 31 + i);
+    }
+}
+
+bool check_pattern(const uint8_t* buf, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != static_cast<uint8_t>(seq * 31 + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Yield until cond() holds (bounded - the poller shares this core)
+template<typename Cond>
+bool wait_for(Cond cond) {
+    for (int i = 0; i < 10'000'000; i++) {
+        if (cond()) {
+            return true;
+        }
+        sched_yield();
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    SimulatedNIC<IntelX710SimModel> sim;
+    assert(sim.create());
+
+    // Test-side view of the registers, to observe what the driver
+    // programs and to play the device for the doorbell checks
+    int bar_fd = open(sim.bar0_path(), O_RDWR);
+    assert(bar_fd >= 0);
+    auto* bar = static_cast<volatile uint8_t*>(
+        mmap(nullptr, SimulatedNIC<IntelX710SimModel>::BAR0_SIZE,
+             PROT_READ | PROT_WRITE, MAP_SHARED, bar_fd, 0));
+    assert(bar != MAP_FAILED);
+    close(bar_fd);
+    auto reg32 = [bar](uint64_t off) -> volatile uint32_t& {
+        return *reinterpret_cast<volatile uint32_t*>(bar + off);
+    };
+
+    const uint32_t RX_SIZE = hft::hardware::RX_RING_SIZE;
+    const size_t NUM_QUEUES = 2;
+
+    MultiQueueNICDriver nic;
+    assert(nic.initialize(sim.bar0_path(), NUM_QUEUES));
+    assert(nic.num_queues() == NUM_QUEUES);
+
+    // ── RSS: key written, indirection table round-robins the queues ──
+    {
+        assert(reg32(reg::RSS_KEY_BASE) != 0);
+        for (size_t i = 0; i < hft::hardware::RSS_TABLE_ENTRIES; i++) {
+            assert(reg32(reg::RSS_TABLE_BASE + i * 4) == i % NUM_QUEUES);
+        }
+    }
+
+    // ── RX through the real polling thread (queue 0) ──
+    const uint32_t TOTAL = 256;
+    const uint64_t TS_BASE = 1'000'000'000;
+    std::atomic<uint32_t> received{0};
+    std::atomic<bool> ok{true};
+
+    // Single-core box: every queue polls on core 0 (the sandbox has no
+    // isolated cores; correctness, not throughput, is under test)
+    int cores[NUM_QUEUES] = {0, 0};
+    assert(nic.start_polling(cores, [&](size_t queue, const RxView* pkts,
+                                        size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t seq = received.load(std::memory_order_relaxed);
+            if (queue != 0 ||
+                pkts[i].len != 64 + (seq % 128) ||
+                !check_pattern(pkts[i].data, pkts[i].len, seq) ||
+                pkts[i].hw_timestamp_ns != TS_BASE + seq) {
+                ok.store(false);
+            }
+            received.fetch_add(1, std::memory_order_release);
+        }
+    }));
+
+    // Queue 0 is live once its polling thread has programmed the ring
+    // (RX_TAIL = RX_SIZE-1 is the last register the setup writes); only
+    // then does queue_arena(0) hold the translations to hand the device
+    assert(wait_for([&] { return reg32(reg::RX_TAIL) == RX_SIZE - 1; }));
+    sim.map_dma_arena(nic.queue_arena(0));
+
+    {
+        uint8_t frame[256];
+        for (uint32_t seq = 0; seq < TOTAL; seq++) {
+            size_t len = 64 + (seq % 128);
+            fill_pattern(frame, len, seq);
+            assert(wait_for([&] { return sim.inject_rx(frame, len,
+                                                       TS_BASE + seq); }));
+        }
+        assert(wait_for([&] {
+            return received.load(std::memory_order_acquire) == TOTAL;
+        }));
+        assert(ok.load());
+        assert(sim.rx_injected() == TOTAL);
+        assert(sim.rx_dropped() == 0);
+    }
+
+    nic.stop();  // Joins the pollers; poll_rx_burst is ours to drive now
+
+    // ── Empty burst: head register outran DD - doorbell must NOT ring ──
+    {
+        const uint32_t head = reg32(reg::RX_HEAD);
+        const uint32_t SENTINEL = 0xABCD1234;
+        reg32(reg::RX_TAIL) = SENTINEL;
+
+        // Device head advances but the slot's DD writeback is not
+        // visible yet (PCIe posts them independently)
+        reg32(reg::RX_HEAD) = (head + 1) & (RX_SIZE - 1);
+
+        RxView views[8];
+        assert(nic.poll_rx_burst(0, views, 8) == 0);
+        assert(reg32(reg::RX_TAIL) == SENTINEL);  // No spurious doorbell
+
+        reg32(reg::RX_HEAD) = head;
+    }
+
+    // ── Non-empty burst: doorbell returns the consumed slots ──
+    {
+        uint8_t frame[64];
+        fill_pattern(frame, sizeof(frame), TOTAL);
+        assert(sim.inject_rx(frame, sizeof(frame), TS_BASE + TOTAL));
+
+        RxView views[8];
+        assert(nic.poll_rx_burst(0, views, 8) == 1);
+        assert(views[0].len == sizeof(frame));
+        assert(check_pattern(views[0].data, views[0].len, TOTAL));
+        assert(reg32(reg::RX_TAIL) == ((TOTAL + 1) & (RX_SIZE - 1)));
+    }
+
+    printf("test_simulated_multiqueue OK\n");
+    return 0;
+}
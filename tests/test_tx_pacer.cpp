@@ -0,0 +1,176 @@
+/**
+ * TxPacer behavior test against a stub driver
+ *
+ * The stub records every stage_tx()/flush_tx() call, so the pacing
+ * decisions are observable without a device. Deadlines are asserted
+ * in absolute wall time via the calibrated TSC clock - the sandbox
+ * may preempt us, so lower bounds are exact and upper bounds generous.
+ * Covered here:
+ *
+ * - Immediate path: tokens cover the send, staged inline, one
+ *   doorbell per pacer step
+ * - A failed stage_tx() does NOT burn bucket tokens - the immediate
+ *   retry succeeds on the same budget
+ * - Empty bucket parks the send on the wheel; run_tx_pacer() refuses
+ *   to release it before the tokens mature and releases it after
+ * - A backlog maturing within one step is released in FIFO order
+ *   under a single doorbell
+ * - Past-the-horizon sends are refused and counted (wheel_rejects)
+ */
+
+#include <ull_nic/tx_pacer.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using hft::hardware::TxPacer;
+using hft::hardware::PacingUnit;
+
+namespace {
+
+/**
+ * Minimal stand-in for the driver's coalescing TX API: records what
+ * the pacer stages and can refuse (full TX ring) on demand
+ */
+struct StubDriver {
+    std::vector<std::vector<uint8_t>> staged;
+    size_t flushes = 0;
+    bool accept = true;
+
+    bool stage_tx(const uint8_t* data, size_t len) {
+        if (!accept) {
+            return false;
+        }
+        staged.emplace_back(data, data + len);
+        return true;
+    }
+
+    void flush_tx() { flushes++; }
+};
+
+uint64_t elapsed_ns(uint64_t tsc_from) {
+    return ull_nic::tsc_clock().to_ns(ull_nic::get_timestamp() - tsc_from);
+}
+
+} // namespace
+
+int main() {
+    ull_nic::tsc_clock();  // Calibrate before timing anything
+
+    StubDriver drv;
+    TxPacer<StubDriver> pacer(drv);
+
+    uint8_t frame_a[100];
+    uint8_t frame_b[100];
+    uint8_t frame_c[100];
+    std::memset(frame_a, 0xA1, sizeof(frame_a));
+    std::memset(frame_b, 0xB2, sizeof(frame_b));
+    std::memset(frame_c, 0xC3, sizeof(frame_c));
+
+    // ── Unconfigured flow is refused outright ──
+    assert(!pacer.send(3, frame_a, sizeof(frame_a)));
+
+    // ── Immediate path: deep bucket, staged inline, one doorbell ──
+    assert(pacer.set_flow_rate(0, 100'000'000, 64 * 1024));  // 100MB/s
+    assert(pacer.send(0, frame_a, sizeof(frame_a)));
+    assert(drv.staged.size() == 1);
+    assert(pacer.get_stats().sent_immediate == 1);
+    assert(pacer.pending() == 0);
+
+    pacer.run_tx_pacer();
+    assert(drv.flushes == 1);  // The step's doorbell covers the stage
+    pacer.run_tx_pacer();
+    assert(drv.flushes == 1);  // Nothing new - no doorbell
+
+    // ── Failed stage_tx() must not burn tokens ──
+    // Flow 1 holds exactly one message of budget at a glacial refill;
+    // if the refused send had been charged, the retry would have to
+    // wait ~1000s and be rejected past the horizon instead
+    assert(pacer.set_flow_rate(1, 1, 1, PacingUnit::MESSAGES));
+    drv.accept = false;
+    assert(!pacer.send(1, frame_a, sizeof(frame_a)));  // Ring "full"
+    drv.accept = true;
+    assert(pacer.send(1, frame_a, sizeof(frame_a)));   // Same budget
+    assert(pacer.get_stats().sent_immediate == 2);
+
+    // ── Horizon: an empty bucket at 1 msg/s defers ~1s - refused ──
+    assert(!pacer.send(1, frame_a, sizeof(frame_a)));
+    assert(pacer.get_stats().wheel_rejects == 1);
+
+    // ── Wheel release: parked until the tokens mature ──
+    // 10k msg/s with a one-message bucket: the second send matures
+    // ~100us after the first drains the bucket
+    assert(pacer.set_flow_rate(2, 10'000, 1, PacingUnit::MESSAGES));
+    assert(pacer.send(2, frame_a, sizeof(frame_a)));   // Drains bucket
+    const uint64_t t0 = ull_nic::get_timestamp();
+    assert(pacer.send(2, frame_b, sizeof(frame_b)));   // Parks on wheel
+    assert(pacer.pending() == 1);
+    const size_t staged_before = drv.staged.size();
+
+    assert(pacer.run_tx_pacer() == 0);  // ~100us early - must hold it
+    assert(drv.staged.size() == staged_before);
+
+    size_t released = 0;
+    while ((released = pacer.run_tx_pacer()) == 0) {
+        // Polling-loop cadence: the pacer is the only timer here
+    }
+    assert(released == 1);
+    assert(elapsed_ns(t0) >= 50'000);  // Not released before maturity
+    assert(pacer.pending() == 0);
+    assert(drv.staged.size() == staged_before + 1);
+    assert(drv.staged.back()[0] == 0xB2);  // The parked frame, verbatim
+    assert(pacer.get_stats().sent_paced == 1);
+
+    // ── Full TX ring at release time: held and retried, never lost ──
+    // Reset to a full one-message bucket and drain it, so the park is
+    // deterministic (tokens accrued while the wheel held the previous
+    // send would otherwise sit right at the one-message edge)
+    assert(pacer.set_flow_rate(2, 10'000, 1, PacingUnit::MESSAGES));
+    assert(pacer.send(2, frame_a, sizeof(frame_a)));   // Drains the bucket
+    assert(pacer.send(2, frame_c, sizeof(frame_c)));   // Parks (~100us)
+    assert(pacer.pending() == 1);
+    const uint64_t t_park = ull_nic::get_timestamp();
+    while (elapsed_ns(t_park) < 200'000) {
+        // Let the deadline mature without servicing the wheel
+    }
+    drv.accept = false;
+    assert(pacer.run_tx_pacer() == 0);  // Due, but the ring refuses
+    assert(pacer.pending() == 1);       // Held, not dropped
+    assert(pacer.get_stats().stage_full == 1);
+    assert(pacer.get_stats().sent_paced == 1);  // Not counted as sent
+
+    drv.accept = true;
+    assert(pacer.run_tx_pacer() == 1);  // Ring drained - released now
+    assert(pacer.pending() == 0);
+    assert(drv.staged.back()[0] == 0xC3);  // The held frame, intact
+
+    // ── Backlog matures during a long gap: FIFO, one doorbell ──
+    // Fresh drained bucket again, then three queued sends spaced
+    // ~100us apart; waiting out all three deadlines before the next
+    // step releases them together
+    assert(pacer.set_flow_rate(2, 10'000, 1, PacingUnit::MESSAGES));
+    assert(pacer.send(2, frame_a, sizeof(frame_a)));   // Immediate drain
+    assert(pacer.send(2, frame_a, sizeof(frame_a)));
+    assert(pacer.send(2, frame_b, sizeof(frame_b)));
+    assert(pacer.send(2, frame_c, sizeof(frame_c)));
+    assert(pacer.pending() == 3);
+
+    const uint64_t t1 = ull_nic::get_timestamp();
+    const size_t flushes_before = drv.flushes;
+    while (elapsed_ns(t1) < 400'000) {
+        // Wait past the last deadline WITHOUT servicing the wheel
+    }
+    assert(pacer.run_tx_pacer() == 3);
+    assert(drv.flushes == flushes_before + 1);  // One doorbell for all
+    assert(pacer.get_stats().max_release_batch >= 3);
+
+    const size_t n = drv.staged.size();
+    assert(drv.staged[n - 3][0] == 0xA1);  // FIFO order preserved
+    assert(drv.staged[n - 2][0] == 0xB2);
+    assert(drv.staged[n - 1][0] == 0xC3);
+
+    printf("test_tx_pacer OK\n");
+    return 0;
+}